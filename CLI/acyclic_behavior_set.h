@@ -21,7 +21,7 @@ namespace structureoptimizer {
 	class AcyclicBehaviorSet : public PermutationSet {
 		public :
 			AcyclicBehaviorSet(){
-				// Do nothing
+				this->scratch = NULL ;
 			}
 
 			AcyclicBehaviorSet( int size ,
@@ -31,42 +31,84 @@ namespace structureoptimizer {
 					permutation.push_back( i ) ;
 				permutation = shuffle( permutation , gen ) ;
 				this->bestScoreCalculator = bestScoreCalculator ;
-				structure = new datastructures::BNStructure( size ) ;
+				this->scratch = NULL ;
 				ancestors = VARSET( size ) ;
 				empty = VARSET( size ) ;
 				updateScore() ;
 			}
 
+			// The scratch structure and lists are rebuilt by the next update
+			AcyclicBehaviorSet( const AcyclicBehaviorSet &other ) : PermutationSet( other ){
+				this->ancestors = other.ancestors ;
+				this->empty = other.empty ;
+				this->undoScore = other.undoScore ;
+				this->scratch = NULL ;
+			}
+
+			~AcyclicBehaviorSet(){
+				delete scratch ;
+			}
+
 			PermutationSet* clone() {
-				// TODO: Do not recalculate structure
-				AcyclicBehaviorSet* set ;
-				set = new AcyclicBehaviorSet( permutation.size() , bestScoreCalculator ) ;
-				set->setPermutation( permutation ) ;
-				return set ;
+				return new AcyclicBehaviorSet( *this ) ;
 			}
 
 			datastructures::BNStructure* getStructure(){
+				if( structure == NULL ) updateScore() ;
 				return structure ;
 			}
 
+			// The structure before the move is kept in scratch, so undoing
+			// it does not score the order again; evaluateSwap goes through
+			// these, with one update per neighbour
+			void applySwap( int idx ){
+				undoScore = getScore() ;
+				std::swap( structure , scratch ) ;
+				std::swap( permutation[ idx ] , permutation[ idx + 1 ] ) ;
+				updateScore() ;
+			}
+
+			void undoSwap( int idx ){
+				std::swap( permutation[ idx ] , permutation[ idx + 1 ] ) ;
+				std::swap( structure , scratch ) ;
+				setScore( undoScore ) ;
+			}
+
 		private :
 			void updateScore( int adjacentPos = -1 ){
 				int variableCount = size() ;
-				m = std::vector<varset>( variableCount , VARSET( variableCount ) ) ;
-				todo = std::vector<varset>( variableCount , VARSET( variableCount ) ) ;
-				structure = new datastructures::BNStructure( variableCount ) ;
+				if( m.size() != variableCount ){
+					m.assign( variableCount , VARSET( variableCount ) ) ;
+					todo.assign( variableCount , VARSET( variableCount ) ) ;
+				}else{
+					for(int i = 0 ; i < variableCount ; i++){
+						VARSET_CLEAR_ALL( m[ i ] ) ;
+						VARSET_CLEAR_ALL( todo[ i ] ) ;
+					}
+				}
+				if( structure == NULL || structure->size() != variableCount ){
+					delete structure ;
+					structure = new datastructures::BNStructure( variableCount ) ;
+				}else{
+					structure->clear() ;
+				}
 
 				for(int j = variableCount - 1 ; j >= 0 ; j--){
 					// Extract variable at position j
 					int v_j = permutation[ j ] ;
 
-					// (a1) Pick best parent set with no descendants of V_j
-					float score = bestScoreCalculator[ v_j ]->getScore( VARSET_NOT( m[ v_j ] ) ) ;
-					varset parents = bestScoreCalculator[ v_j ]->getParents() ;
+					// (a1) Pick best parent set with no descendants of V_j, by index
+					// if possible so copies of the set can be scored concurrently
+					varset options = VARSET_NOT( m[ v_j ] ) ;
+					int index ;
+					float score = bestScoreCalculator[ v_j ]->getScore( options , index ) ;
+					varset parents = VARSET( variableCount ) ;
+					if( index < 0 ) parents = bestScoreCalculator[ v_j ]->getParents() ;
+					else if( index < bestScoreCalculator[ v_j ]->size() ) parents = bestScoreCalculator[ v_j ]->getParents( index ) ;
 					structure->setParents( v_j , parents , score ) ;
 
 					// (a2) Update matrix representation and get ancestors of V_j
-					ancestors = VARSET( variableCount ) ;
+					VARSET_CLEAR_ALL( ancestors ) ;
 					for(int i = 0 ; i < variableCount  ; i++){
 						if( VARSET_GET( parents , i ) || ( m[ i ] & parents ).any() )
 							VARSET_SET( m[ i ] , v_j ) ;
@@ -77,7 +119,7 @@ namespace structureoptimizer {
 					// (b) Start an empty TODO list to all ancestors of V_j
 					for(int i = 0 ; i < variableCount ; i++)
 						if( VARSET_GET( ancestors , i ) )
-							todo[ i ] = VARSET( variableCount ) ;
+							VARSET_CLEAR_ALL( todo[ i ] ) ;
 
 					// (c) Start TODO lists of the parents of V_j with descendants of V_j
 					for(int i = 0 ; i < variableCount ; i++)
@@ -99,7 +141,7 @@ namespace structureoptimizer {
 				if( ancestors == empty ) return ;
 				VARSET_CLEAR( ancestors , x ) ;
 				int variableCount = size() ;
-				std::vector<int> children = (*structure)[ x ]->getChildrenVector() ;
+				const std::vector<int> &children = (*structure)[ x ]->getChildrenVector() ;
 				for( int i = 0 ; i < children.size() ; i++){
 					int ch = children[ i ] ;
 					if( VARSET_GET( ancestors , ch ) ){
@@ -127,6 +169,10 @@ namespace structureoptimizer {
 			std::vector<varset> todo ; // To-Do lists
 			varset empty ;
 			varset ancestors ;
+
+			// the structure and score before the last applySwap
+			datastructures::BNStructure* scratch ;
+			float undoScore ;
 	} ;
 }
 
@@ -12,7 +12,7 @@
 #include "permutation_set_creator.h"
 
 structureoptimizer::AcyclicSelection::AcyclicSelection(){
-	// Do nothing
+	this->evaluator = NULL ;
 }
 
 structureoptimizer::AcyclicSelection::AcyclicSelection( initializers::Initializer* initializer ,
@@ -22,23 +22,29 @@ structureoptimizer::AcyclicSelection::AcyclicSelection( initializers::Initialize
 	this->bestScoreCalculators = bestScoreCalculator ;
 	this->variableCount = bestScoreCalculator.size() ;
 	setParameters( parametersFile ) ;
+	this->evaluator = new NeighbourhoodEvaluator( this->bestScoreCalculators , threadCount ) ;
 }
 
 structureoptimizer::AcyclicSelection::~AcyclicSelection(){
-	// Do nothing
+	delete evaluator ;
 }
 
 void structureoptimizer::AcyclicSelection::setDefaultParameters(){
 	this->maxIterations = 500 ;
+	this->threadCount = 1 ;
 }
 
 void structureoptimizer::AcyclicSelection::setFileParameters( std::map<std::string,std::string> params ){
 	if( params.count( "max_iterations" ) )
 		sscanf( params[ "max_iterations" ].c_str() , "%d" , &maxIterations ) ;
+
+	if( params.count( "threads" ) )
+		sscanf( params[ "threads" ].c_str() , "%d" , &threadCount ) ;
 }
 
 void structureoptimizer::AcyclicSelection::printParameters(){
 	printf( "Max number of iterations: %d\n" , maxIterations ) ;
+	printf( "Threads: %d\n" , evaluator->getThreadCount() ) ;
 }
 
 void structureoptimizer::AcyclicSelection::initialize(){
@@ -54,9 +60,13 @@ datastructures::BNStructure structureoptimizer::AcyclicSelection::search_interna
 	int numIterations = 0 ;
 	for(int i = 0 ; i < maxIterations && !outOfTime ; i++,numIterations++){
 		structureoptimizer::PermutationSet* bestNeighbour = findBestNeighbour( current ) ;
-		if( !bestNeighbour->isBetter( *current ) ) break ;
+		if( !bestNeighbour->isBetter( *current ) ){
+			delete bestNeighbour ;
+			break ;
+		}
 		printf(" === Iteration %d ===\n" , i+1 ) ;
-		current = bestNeighbour->clone() ;
+		delete current ;
+		current = bestNeighbour ;
 		current->print() ;
 	}
 	printf("Iterations = %d\n" , numIterations ) ;
@@ -65,17 +75,14 @@ datastructures::BNStructure structureoptimizer::AcyclicSelection::search_interna
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::AcyclicSelection::findBestNeighbour( structureoptimizer::PermutationSet* set ){
-	structureoptimizer::PermutationSet* bestN = set->clone() ;
-	for(int i = 0 ; i < variableCount - 1 ; i++){
-		structureoptimizer::PermutationSet* neighbour = doSwap( set , i ) ;
-		if( !neighbour->isBetter( *bestN ) ) continue ;
-		bestN = neighbour->clone() ;
-	}
-	return bestN ;
+	// Only score the neighbours, the best one is built at the end
+	int bestSwap = evaluator->findBestSwap( set ) ;
+	if( bestSwap < 0 ) return set->clone() ;
+	return doSwap( set , bestSwap ) ;
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::AcyclicSelection::doSwap( structureoptimizer::PermutationSet* set , int index ){
 	structureoptimizer::PermutationSet* newSet = set->clone();
-	newSet->swap( index , index + 1 ) ;
+	newSet->applySwap( index ) ;
 	return newSet ;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #define	ACYCLIC_SELECTION_H
 
 #include "structure_optimizer.h"
+#include "neighbourhood_evaluator.h"
 #include "bn_structure.h"
 
 namespace structureoptimizer {
@@ -32,10 +33,12 @@ namespace structureoptimizer {
 			void setFileParameters( std::map<std::string, std::string> params ) ;
 
 			PermutationSet* current ;
+			NeighbourhoodEvaluator* evaluator ;
 
 			// Configuration variables
 			int maxIterations ;
 			bool testFlag ;
+			int threadCount ;
 	} ;
 }
 
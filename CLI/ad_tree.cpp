@@ -12,6 +12,7 @@
 
 scoring::ADTree::ADTree(int rMin) {
 	this->rMin = rMin;
+	this->root = NULL;
 }
 
 void scoring::ADTree::initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile) {
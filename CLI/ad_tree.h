@@ -24,20 +24,26 @@ namespace scoring {
 	class ADTree {
 		public:
 			ADTree() {
-				// do nothing
+				root = NULL;
 			}
 			ADTree(int rMin);
-			~ADTree() {
+			virtual ~ADTree() {
 				if (root != NULL) {
 					delete root;
 				}
 				root = NULL;
 			}
 
-			void initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile);
-			void createTree();
+			virtual void initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile);
+			virtual void createTree();
+
+			virtual ContingencyTableNode* makeContab(varset variables);
 
-			ContingencyTableNode* makeContab(varset variables);
+		protected:
+			datastructures::BayesianNetwork network;
+			int recordCount;
+			int rMin;
+			varset zero;
 
 		private:
 			ADNode* makeADTree(int i, bitset &recordNums, int depth, varset variables);
@@ -48,12 +54,7 @@ namespace scoring {
 
 			std::vector< std::vector< bitset > > consistentRecords;
 
-			datastructures::BayesianNetwork network;
-			int recordCount;
-			int rMin;
-
 			ADNode *root;
-			varset zero;
 	} ;
 }
 
@@ -0,0 +1,53 @@
+/*
+ * File:   ad_tree_creator.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef AD_TREE_CREATOR_H
+#define	AD_TREE_CREATOR_H
+
+#include <stdexcept>
+#include <string>
+
+#include "ad_tree.h"
+#include "bitset_counter.h"
+#include "flat_ad_tree.h"
+
+namespace scoring {
+
+	static std::string adTreeTypeString = "The AD-tree implementation used for counting. [\"pointer\", \"flat\"]" ;
+
+	inline ADTree* createADTree( std::string type , int rMin ){
+		ADTree *adTree ;
+		if( type == "pointer" ){
+			adTree = new ADTree( rMin ) ;
+		}else if( type == "flat" ){
+			adTree = new FlatADTree( rMin ) ;
+		}else{
+			throw std::runtime_error( "Invalid AD-tree type: '" + type + "'.  Valid options are 'pointer' and 'flat'." ) ;
+		}
+		return adTree ;
+	}
+
+	static std::string counterTypeString = "The engine used for counting records. [\"adtree\", \"bitset\"]" ;
+
+	/**
+	 * Create the counting engine.  Both engines build the same contingency
+	 * tables; "adtree" uses the AD-tree selected by {@code adTreeType}.
+	 */
+	inline ADTree* createCounter( std::string type , std::string adTreeType , int rMin ){
+		ADTree *counter ;
+		if( type == "adtree" ){
+			counter = createADTree( adTreeType , rMin ) ;
+		}else if( type == "bitset" ){
+			counter = new BitsetCounter() ;
+		}else{
+			throw std::runtime_error( "Invalid counter type: '" + type + "'.  Valid options are 'adtree' and 'bitset'." ) ;
+		}
+		return counter ;
+	}
+}
+
+#endif	/* AD_TREE_CREATOR_H */
@@ -23,8 +23,8 @@ datastructures::BayesianNetwork::~BayesianNetwork() {
 }
 
 void datastructures::BayesianNetwork::initialize(datastructures::RecordFile &recordFile) {
-	printf("Num. of variables: %d\n", recordFile.getRecords()[0].size());
-	for (int i = 0; i < recordFile.getRecords()[0].size(); i++) {
+	printf("Num. of variables: %d\n", recordFile.getColumnCount());
+	for (int i = 0; i < recordFile.getColumnCount(); i++) {
 		datastructures::Variable *v = new datastructures::Variable(this, i);
 		variables.push_back(v);
 
@@ -162,18 +162,32 @@ std::vector< std::vector< bitset > > datastructures::BayesianNetwork::getConsist
 		}
 	}
 
-	for (int index = 0; index < recordFile.size(); index++) {
-		Record record = recordFile.getRecords()[index];
-		for (int variable = 0; variable < size(); variable++) {
-			std::string v = record.get(variable);
-			int value = get(variable)->getValueIndex(v);
-			BITSET_SET(consistentRecords[variable][value], index);
+	for (int variable = 0; variable < size(); variable++) {
+		DataColumn &column = recordFile.getColumn(variable);
+		std::vector<int> valueIndices = get(variable)->getValueIndices(column);
+		for (int index = 0; index < recordFile.size(); index++) {
+			BITSET_SET(consistentRecords[variable][valueIndices[column.get(index)]], index);
 		}
 	}
 
 	return consistentRecords;
 }
 
+/**
+ * Get the value index of every record, one column per variable.
+ */
+std::vector< std::vector< uint16_t > > datastructures::BayesianNetwork::getValueColumns(datastructures::RecordFile &recordFile) {
+	std::vector< std::vector< uint16_t > > columns(size(), std::vector< uint16_t >(recordFile.size()));
+	for (int variable = 0; variable < size(); variable++) {
+		DataColumn &column = recordFile.getColumn(variable);
+		std::vector<int> valueIndices = get(variable)->getValueIndices(column);
+		for (int index = 0; index < recordFile.size(); index++) {
+			columns[variable][index] = valueIndices[column.get(index)];
+		}
+	}
+	return columns;
+}
+
 void datastructures::BayesianNetwork::addValues(RecordFile &recordFile) {
 	for (auto it = variables.begin(); it < variables.end(); it++) {
 		(*it)->addValues(recordFile);
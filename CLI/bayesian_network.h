@@ -8,6 +8,7 @@
 #ifndef BAYESIAN_NETWORK_H
 #define	BAYESIAN_NETWORK_H
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,7 @@ namespace datastructures {
 			int getMaxCardinality();
 
 			std::vector< std::vector< bitset > > getConsistentRecords(RecordFile &recordFile);
+			std::vector< std::vector< uint16_t > > getValueColumns(RecordFile &recordFile);
 		
 		private:
 			void addValues(RecordFile &recordFile);
@@ -32,10 +32,11 @@ namespace datastructures {
 				return q.size() ;
 			}
 
+			// The list owns the sets added to it, and deletes the ones it drops
 			void add( _ItemType node ){
 				if( !has( node ) ){
 					q.insert( node ) ;
-					if( size() > maxSize ) pop() ;
+					if( size() > maxSize ) delete pop() ;
 				}
 			}
 
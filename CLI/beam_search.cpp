@@ -16,6 +16,7 @@
 
 #include "beam_list.h"
 #include "beam_search.h"
+#include "utils.h"
 
 structureoptimizer::BeamSearch::BeamSearch(){
 	// Do nothing
@@ -63,15 +64,15 @@ void structureoptimizer::BeamSearch::initialize(){
 datastructures::BNStructure structureoptimizer::BeamSearch::search_internal(){
 	boost::timer::auto_cpu_timer cpu( 6 , "CPU time = %w\n" ) ; // TODO: Rethink location of timer
 
+	structureoptimizer::PermutationSet* best = current->clone() ;
 	datastructures::BeamList<> q( queueLength ) ;
 	q.add( current ) ;
 
-	structureoptimizer::PermutationSet* best = current ;
-	std::vector<structureoptimizer::PermutationSet*> convergent ;
 	int numIterations = 0 ;
 	for(int k = 0 ; k < maxDepth && !q.empty() && !outOfTime ; k++,numIterations++){
 		updateLayer( q ) ;
 		if( !q.empty() && (*q.top()) < (*best) ){
+			delete best ;
 			best = q.top()->clone() ;
 			printf(" === Iteration %d ===\n" , k+1 ) ;
 			best->print() ;
@@ -79,17 +80,23 @@ datastructures::BNStructure structureoptimizer::BeamSearch::search_internal(){
 	}
 	printf("Iterations = %d\n" , numIterations ) ;
 	t->cancel() ;
-	return *(best->getStructure()) ;
+	while( !q.empty() ) delete q.pop() ;
+	datastructures::BNStructure structure = *(best->getStructure()) ;
+	delete best ;
+	return structure ;
 }
 
 void structureoptimizer::BeamSearch::updateLayer( datastructures::BeamList<> &q ){
 	datastructures::BeamList<> beam( queueLength ) ;
 	while( !q.empty() && !outOfTime ){
-		structureoptimizer::PermutationSet* best = q.pop()->clone() ;
-		datastructures::BeamList<> neighbours = getNeighbours( best ) ;
+		structureoptimizer::PermutationSet* set = q.pop() ;
+		datastructures::BeamList<> neighbours = getNeighbours( set ) ;
+		delete set ;
 		if( !neighbours.empty() )
 			beam.add( neighbours ) ;
 	}
+	// the sets left when the time runs out are not expanded
+	while( !q.empty() ) delete q.pop() ;
 	q = beam ;
 }
 
@@ -97,9 +104,9 @@ datastructures::BeamList<> structureoptimizer::BeamSearch::getNeighbours(
 									structureoptimizer::PermutationSet* currentState ){
 	datastructures::BeamList<> neighbours( queueLength ) ;
 	for(int i = 0 ; i < variableCount - 1 ; i++){
-		structureoptimizer::PermutationSet* neighbour = doSwap( currentState , i ) ;
-		if( !neighbour->isBetter( *currentState ) ) continue ; // Prune worse solutions
-		neighbours.add( neighbour->clone() ) ;
+		float score = currentState->evaluateSwap( i ) ;
+		if( compare( score , currentState->getScore() ) >= 0 ) continue ; // Prune worse solutions
+		neighbours.add( doSwap( currentState , i ) ) ;
 	}
 	return neighbours ;
 }
@@ -107,6 +114,6 @@ datastructures::BeamList<> structureoptimizer::BeamSearch::getNeighbours(
 structureoptimizer::PermutationSet* structureoptimizer::BeamSearch::doSwap(
 									structureoptimizer::PermutationSet* set , int index ){
 	structureoptimizer::PermutationSet* newSet = set->clone() ;
-	newSet->swap( index , index + 1 ) ;
+	newSet->applySwap( index ) ;
 	return newSet ;
 }
\ No newline at end of file
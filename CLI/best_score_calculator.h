@@ -23,6 +23,37 @@ namespace bestscorecalculators {
 			virtual void initialize(const scoring::ScoreCache &scoreCache) = 0;
 			virtual int size() = 0;
 			virtual void print() = 0;
+
+			/*
+			 * Incremental lookups.  index is the position of the best parent
+			 * set of pars in the order of getScore(int), size() if pars
+			 * contains none of them, or -1 if the calculator has no such order.
+			 * The Adding and Removing versions expect the index found for pars
+			 * without {@code added} or with {@code removed}, and update it.
+			 * Unlike getScore(varset&), they do not change getParents().
+			 *
+			 * By default, they look the score up again.
+			 */
+			virtual float getScore(varset &pars, int &index) {
+				index = -1;
+				return getScore(pars);
+			}
+
+			virtual float getScoreAdding(varset &pars, int added, int &index) {
+				return getScore(pars, index);
+			}
+
+			virtual float getScoreRemoving(varset &pars, int removed, int &index) {
+				return getScore(pars, index);
+			}
+
+			/*
+			 * Whether the lookups by index above and getParents(int) only read
+			 * the calculator, so several threads may make them at once.
+			 */
+			virtual bool isConcurrent() {
+				return false;
+			}
 	};
 }
 
@@ -17,11 +17,12 @@
 #include "best_score_calculator.h"
 #include "sparse_parent_bitwise.h"
 #include "sparse_parent_list.h"
+#include "sparse_parent_simd.h"
 #include "sparse_parent_tree.h"
 
 namespace bestscorecalculators {
     
-	static std::string bestScoreCalculatorString = "The data structure to use for BestScore calculations. [\"list\", \"tree\", \"bitwise\"]";
+	static std::string bestScoreCalculatorString = "The data structure to use for BestScore calculations. [\"list\", \"tree\", \"bitwise\", \"simd\"]";
 
 	inline std::vector<BestScoreCalculator*> create(std::string type, scoring::ScoreCache &cache) {
 		std::vector<BestScoreCalculator*> spgs;
@@ -33,8 +34,10 @@ namespace bestscorecalculators {
 				spg = new SparseParentBitwise(i, cache.getVariableCount());
 			} else if (type == "list") {
 				spg = new SparseParentList(i, cache.getVariableCount());
+			} else if (type == "simd") {
+				spg = new SparseParentSimd(i, cache.getVariableCount());
 			} else {
-				throw std::runtime_error("Invalid BestScore calculator type: '" + type + "'.  Valid options are 'tree', 'bitwise' and 'list'.");
+				throw std::runtime_error("Invalid BestScore calculator type: '" + type + "'.  Valid options are 'tree', 'bitwise', 'list' and 'simd'.");
 			}
 
 			spg->initialize( cache ) ;
@@ -46,7 +46,8 @@ int initializers::BFirstInitializer::getRandomVariable(){
 	// Get possible options
 	for(int i = 0 ; i < variableCount ; i++){
 		if( !VARSET_GET( unvisitedVariables , i ) ) continue ;
-		float bestSc = bestScoreCalculators[ i ]->getScore( unvisitedVariables ) ;
+		int index ;
+		float bestSc = bestScoreCalculators[ i ]->getScore( unvisitedVariables , index ) ;
 		options.push_back( PAIR( bestSc , i ) ) ;
 	}
 	std::sort( options.begin() , options.end() ) ;
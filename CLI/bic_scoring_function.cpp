@@ -24,6 +24,16 @@ scoring::BICScoringFunction::BICScoringFunction( datastructures::BayesianNetwork
 
 	this->llc = llc ;
 	this->whileCalculatingPruning = whileCalculatingPruning ;
+
+	for( int variable = 0 ; variable < network.size() ; variable++){
+		int cardinality = 0 ;
+		for( int x = 0 ; x < network.size() ; x++){
+			if( x == variable ) continue ;
+			int r = this->network.getCardinality( x ) ;
+			if( cardinality == 0 || r < cardinality ) cardinality = r ;
+		}
+		minParentCardinality.push_back( std::max( cardinality , 1 ) ) ;
+	}
 }
 
 scoring::BICScoringFunction::~BICScoringFunction(){
@@ -36,14 +46,22 @@ float scoring::BICScoringFunction::t( int variable , varset parents ){
 	return penalty ;
 }
 
+/**
+ * Check if {@code parents} was skipped because of the constraints.  This is
+ * asked of the constraints directly instead of remembering the skipped sets,
+ * so the scoring threads share no mutable state.
+ */
+bool scoring::BICScoringFunction::isInvalidParents( int variable , varset &parents ){
+	return constraints != NULL && !constraints->satisfiesConstraints( variable , parents ) ;
+}
+
 float scoring::BICScoringFunction::calculateScore( int variable , varset parents ,
 													FloatMap &pruned , FloatMap &cache ){
 	// Check if it was already calculated
 	if( cache.count( parents ) ) return cache[ parents ] ;
 	
 	// Check if this violates the constraints
-	if( constraints != NULL && !constraints->satisfiesConstraints( variable , parents ) ){
-		invalidParents.insert( parents ) ;
+	if( isInvalidParents( variable , parents ) ){
 		return 1 ;
 	}
 
@@ -57,7 +75,7 @@ float scoring::BICScoringFunction::calculateScore( int variable , varset parents
 			if( VARSET_GET( parents , x ) ){
 				VARSET_CLEAR( parents , x ) ;
 				// check the constraints
-				if( invalidParents.size() > 0 && invalidParents.count( parents ) > 0 ){
+				if( isInvalidParents( variable , parents ) ){
 					// we cannot say anything if we skipped this because of constraints
 					VARSET_SET( parents , x ) ;
 					continue ;
@@ -86,6 +104,68 @@ float scoring::BICScoringFunction::calculateScore( int variable , varset parents
 	return score ;
 }
 
+/**
+ * The number of subsets of {@code parents} with one variable less which
+ * satisfy the constraints.
+ */
+int scoring::BICScoringFunction::countValidSubsets( int variable , varset parents ){
+	if( constraints == NULL ) return cardinality( parents ) ;
+	int count = 0 ;
+	for( int word = 0 ; 64 * word < (int) parents.size() ; word++){
+		uint64_t bits = varsetWord( parents , word ) ;
+		while( bits ){
+			int x = 64 * word + __builtin_ctzll( bits ) ;
+			bits &= bits - 1 ;
+			VARSET_CLEAR( parents , x ) ;
+			if( !isInvalidParents( variable , parents ) ) count++ ;
+			VARSET_SET( parents , x ) ;
+		}
+	}
+	return count ;
+}
+
+/**
+ * The same pruning as above, but the search already knows the best score of
+ * the subsets and whether any of them was pruned, so nothing is looked up.
+ * A subset scoring better than -t( parents ) is better than any score of
+ * parents, which is the test above applied to all of the subsets instead
+ * of only the immediate ones.
+ */
+float scoring::BICScoringFunction::calculateScore( int variable , varset parents ,
+													float bestSubsetScore , int keptSubsets ){
+	// Check if this violates the constraints
+	if( isInvalidParents( variable , parents ) ){
+		return 1 ;
+	}
+
+	float tVal = t( variable , parents ) ;
+
+	if( whileCalculatingPruning ){
+		// a subset was pruned, so this can be pruned too
+		if( keptSubsets < countValidSubsets( variable , parents ) ) return 1 ;
+
+		if( compare( bestSubsetScore + tVal ) > 0 ) return 1 ;
+	}
+
+	float score = llc->calculate( variable , parents ) ;
+	// structure penalty
+	score -= tVal * baseComplexityPenalty ;
+	return score ;
+}
+
+/**
+ * A strict superset of {@code parents} has at least one more parent, so its
+ * penalty is at least t( parents ) times the fewest states of a parent.  Its
+ * log-likelihood is at most 0, that is, it gains at most N * H( X | parents )
+ * over {@code parents}, so its score is at most minus that penalty.  If
+ * {@code bestScore} is already better, every superset is pruned.
+ */
+bool scoring::BICScoringFunction::canImproveSupersets( int variable , varset &parents , float bestScore ){
+	if( !whileCalculatingPruning ) return true ;
+	float minPenalty = t( variable , parents ) * minParentCardinality[ variable ] * baseComplexityPenalty ;
+	return compare( bestScore + minPenalty ) <= 0 ;
+}
+
 approxStruct scoring::BICScoringFunction::approximateScore( int variable , varset parents ,
 															FloatMap &pruned ,
 															FloatMap &cache ,
@@ -129,7 +209,7 @@ approxStruct scoring::BICScoringFunction::approximateScore( int variable , varse
 			if( VARSET_GET( parents , x ) ){
 				VARSET_CLEAR( parents , x ) ;
 				// check the constraints
-				if( invalidParents.size() > 0 && invalidParents.count( parents ) > 0 ){
+				if( isInvalidParents( variable , parents ) ){
 					// we can not say anything if we skipped this because of constraints
 					VARSET_SET( parents , x ) ;
 					continue ;
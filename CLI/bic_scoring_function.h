@@ -35,6 +35,9 @@ namespace scoring {
 
 			float calculateScore( int variable , varset parents , 
 									FloatMap &pruned , FloatMap &cache ) ;
+			float calculateScore( int variable , varset parents ,
+									float bestSubsetScore , int keptSubsets ) ;
+			bool canImproveSupersets( int variable , varset &parents , float bestScore ) ;
 			approxStruct approximateScore( int variable , varset parents ,
 											FloatMap &pruned , FloatMap &cache ,
 											ApproxMap &openCache ) ;
@@ -43,15 +46,18 @@ namespace scoring {
 
 		private:
 			float t( int variable , varset parents ) ;
+			bool isInvalidParents( int variable , varset &parents ) ;
+			int countValidSubsets( int variable , varset parents ) ;
 
 			datastructures::BayesianNetwork network ;
 			Constraints *constraints ;
-			boost::unordered_set<varset> invalidParents ;
 			LogLikelihoodCalculator *llc ;
 
 
 			float baseComplexityPenalty ;
 			int recordFileSize ;
+			// for each variable, the fewest states of any other variable
+			std::vector<int> minParentCardinality ;
 			bool whileCalculatingPruning ;
 	} ;
 }
@@ -0,0 +1,151 @@
+/*
+ * File:   bitset_counter.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <iterator>
+
+#include "bitset_counter.h"
+
+const size_t scoring::BitsetCounter::MAX_CACHE_BYTES;
+
+scoring::BitsetCounter::BitsetCounter() : ADTree() {
+	words = 0;
+}
+
+scoring::BitsetCounter::~BitsetCounter() {
+	// no pointers
+}
+
+void scoring::BitsetCounter::initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile) {
+	this->network = network;
+	this->recordCount = recordFile.size();
+	VARSET_NEW(empty, network.size());
+	zero = empty;
+
+	// copy the bitsets into plain 64-bit words so the loops below vectorize
+	words = (recordCount + 63) / 64;
+	std::vector< std::vector< bitset > > consistentRecords = network.getConsistentRecords(recordFile);
+	valueRecords.resize(network.size());
+	for (int variable = 0; variable < network.size(); variable++) {
+		for (auto value = consistentRecords[variable].begin(); value != consistentRecords[variable].end(); value++) {
+			Records records(words, 0);
+			for (int index = value->find_first(); index != bitset::npos; index = value->find_next(index)) {
+				records[index / 64] |= 1ULL << (index % 64);
+			}
+			valueRecords[variable].push_back(records);
+		}
+	}
+}
+
+void scoring::BitsetCounter::createTree() {
+	// nothing to build
+}
+
+scoring::ContingencyTableNode* scoring::BitsetCounter::makeContab(varset variables) {
+	std::vector<int> sorted;
+	for (int x = 0; x < network.size(); x++) {
+		if (VARSET_GET(variables, x)) {
+			sorted.push_back(x);
+		}
+	}
+
+	if (sorted.size() == 0) {
+		return new ContingencyTableNode(recordCount, 0, 1);
+	}
+
+	VARSET_NEW(prefix, network.size());
+	return makeContab(sorted, 0, prefix, 0, NULL, getCache());
+}
+
+/**
+ * Build the subtable of the configuration {@code configuration} of the
+ * first {@code depth} variables, whose records are {@code records} (all of
+ * them at depth 0).
+ */
+scoring::ContingencyTableNode* scoring::BitsetCounter::makeContab(std::vector<int> &variables, int depth, varset &prefix,
+		uint64_t configuration, const uint64_t *records, Cache &cache) {
+	int variable = variables[depth];
+	int cardinality = network.getCardinality(variable);
+	bool last = (depth == variables.size() - 1);
+
+	ContingencyTableNode *ct = new ContingencyTableNode(0, cardinality, 0);
+	VARSET_SET(prefix, variable);
+
+	for (int k = 0; k < cardinality; k++) {
+		const uint64_t *value = &valueRecords[variable][k][0];
+
+		ContingencyTableNode *child = NULL;
+		if (last) {
+			int count = countIntersection(records == NULL ? value : records, value);
+
+			if (count > 0) {
+				child = new ContingencyTableNode(count, 0, 1);
+			}
+		} else {
+			const uint64_t *childRecords = (records == NULL ? value : intersect(prefix, configuration * cardinality + k, records, value, cache));
+			if (childRecords != NULL) {
+				child = makeContab(variables, depth + 1, prefix, configuration * cardinality + k, childRecords, cache);
+			}
+		}
+
+		if (child != NULL) {
+			ct->setChild(k, child);
+			ct->leafCount += child->leafCount;
+		}
+	}
+
+	VARSET_CLEAR(prefix, variable);
+	return ct;
+}
+
+/**
+ * Get the records of {@code configuration} of {@code prefix}, which are the
+ * intersection of {@code records} and {@code valueRecords}, from the cache
+ * if possible.  NULL means that no record is consistent.
+ */
+const uint64_t *scoring::BitsetCounter::intersect(varset &prefix, uint64_t configuration, const uint64_t *records,
+		const uint64_t *valueRecords, Cache &cache) {
+	Intersections &intersections = cache.prefixes[prefix];
+	auto it = intersections.find(configuration);
+	if (it == intersections.end()) {
+		Records intersection(words);
+		int count = 0;
+		for (int w = 0; w < words; w++) {
+			intersection[w] = records[w] & valueRecords[w];
+			count += __builtin_popcountll(intersection[w]);
+		}
+		if (count == 0) {
+			intersection.clear();
+		}
+
+		cache.bytes += intersection.size() * sizeof (uint64_t);
+		it = intersections.insert(std::make_pair(configuration, intersection)).first;
+	}
+
+	return (it->second.size() == 0 ? NULL : &it->second[0]);
+}
+
+int scoring::BitsetCounter::countIntersection(const uint64_t *a, const uint64_t *b) {
+	int count = 0;
+	for (int w = 0; w < words; w++) {
+		count += __builtin_popcountll(a[w] & b[w]);
+	}
+	return count;
+}
+
+scoring::BitsetCounter::Cache &scoring::BitsetCounter::getCache() {
+	if (cache.get() == NULL) {
+		cache.reset(new Cache());
+		cache->bytes = 0;
+	}
+
+	// only cleared between queries, while no pointers into it are held
+	if (cache->bytes > MAX_CACHE_BYTES) {
+		cache->prefixes.clear();
+		cache->bytes = 0;
+	}
+	return *cache;
+}
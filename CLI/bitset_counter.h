@@ -0,0 +1,73 @@
+/*
+ * File:   bitset_counter.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BITSET_COUNTER_H
+#define	BITSET_COUNTER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <boost/thread/tss.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "ad_tree.h"
+#include "bayesian_network.h"
+#include "contingency_table_node.h"
+#include "record_file.h"
+#include "typedefs.h"
+
+namespace scoring {
+
+	/**
+	 * Builds contingency tables without an AD-tree, by intersecting the
+	 * record bitsets of BayesianNetwork::getConsistentRecords.
+	 *
+	 * The table of X_1 < ... < X_k is built depth first; the records
+	 * consistent with x_1 ... x_d are the AND of the bitsets of the values, and
+	 * the count of a leaf is a popcount.  The intersections of the partial
+	 * configurations are cached per thread, so sibling parent sets which share
+	 * their lowest variables do not intersect those again.  This works best
+	 * for data sets with few values per variable.
+	 */
+	class BitsetCounter : public ADTree {
+		public:
+			BitsetCounter();
+			~BitsetCounter();
+
+			void initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile);
+			void createTree();
+
+			ContingencyTableNode* makeContab(varset variables);
+
+		private:
+			typedef std::vector<uint64_t> Records;
+
+			// the intersections of the configurations of one prefix of variables
+			typedef boost::unordered_map<uint64_t, Records> Intersections;
+
+			struct Cache {
+				boost::unordered_map<varset, Intersections> prefixes;
+				size_t bytes;
+			};
+
+			ContingencyTableNode* makeContab(std::vector<int> &variables, int depth, varset &prefix,
+					uint64_t configuration, const uint64_t *records, Cache &cache);
+			const uint64_t *intersect(varset &prefix, uint64_t configuration, const uint64_t *records,
+					const uint64_t *valueRecords, Cache &cache);
+
+			int countIntersection(const uint64_t *a, const uint64_t *b);
+			Cache &getCache();
+
+			static const size_t MAX_CACHE_BYTES = 1 << 27;
+
+			int words;
+			std::vector< std::vector<Records> > valueRecords;
+			boost::thread_specific_ptr<Cache> cache;
+	} ;
+}
+
+#endif	/* BITSET_COUNTER_H */
@@ -11,7 +11,42 @@
 #include "typedefs.h"
 
 datastructures::BNStructure::BNStructure(){
-	// Do nothing
+	variableCount = 0 ;
+	structureScore = 0. ;
+}
+
+datastructures::BNStructure::BNStructure( const datastructures::BNStructure &other ){
+	copyNodes( other ) ;
+}
+
+datastructures::BNStructure::~BNStructure(){
+	deleteNodes() ;
+}
+
+// Reuses the nodes if both structures have as many
+datastructures::BNStructure& datastructures::BNStructure::operator =( const datastructures::BNStructure &other ){
+	if( this == &other ) return *this ;
+	if( nodes.size() == other.nodes.size() ){
+		for(int i = 0 ; i < nodes.size() ; i++) *nodes[ i ] = *other.nodes[ i ] ;
+		variableCount = other.variableCount ;
+		structureScore = other.structureScore ;
+	}else{
+		deleteNodes() ;
+		copyNodes( other ) ;
+	}
+	return *this ;
+}
+
+void datastructures::BNStructure::copyNodes( const datastructures::BNStructure &other ){
+	for(int i = 0 ; i < other.nodes.size() ; i++)
+		nodes.push_back( new structureoptimizer::Node( *other.nodes[ i ] ) ) ;
+	variableCount = other.variableCount ;
+	structureScore = other.structureScore ;
+}
+
+void datastructures::BNStructure::deleteNodes(){
+	for(int i = 0 ; i < nodes.size() ; i++) delete nodes[ i ] ;
+	nodes.clear() ;
 }
 
 datastructures::BNStructure::BNStructure( int size ){
@@ -34,8 +69,12 @@ datastructures::BNStructure::BNStructure( structureoptimizer::PermutationSet* or
 	for(int i = 0 ; i < variableCount ; i++){
 		varset options = order->getVarset( i ) ;
 		int variable = (*order)[ i ] ;
-		float score = bsc[ variable ]->getScore( options ) ;
-		varset parents = bsc[ variable ]->getParents() ;
+		// by index if possible, so searches may share the calculators
+		int index ;
+		float score = bsc[ variable ]->getScore( options , index ) ;
+		varset parents = VARSET( variableCount ) ;
+		if( index < 0 ) parents = bsc[ variable ]->getParents() ;
+		else if( index < bsc[ variable ]->size() ) parents = bsc[ variable ]->getParents( index ) ;
 		setParents( variable , parents , score ) ;
 		for(int j = 0 ; j < variableCount ; j++){
 			if( !VARSET_GET( parents , j ) ) continue ;
@@ -78,7 +117,7 @@ float datastructures::BNStructure::getScore(){
 	return structureScore ;
 }
 
-bool datastructures::BNStructure::isBetter( datastructures::BNStructure other ){
+bool datastructures::BNStructure::isBetter( datastructures::BNStructure &other ){
 	return compare( other.getScore() , structureScore ) > 0 ;
 }
 
@@ -97,6 +136,11 @@ void datastructures::BNStructure::setParents( int indexnode , varset parents , f
 	}
 }
 
+void datastructures::BNStructure::clear(){
+	for(int i = 0 ; i < nodes.size() ; i++) nodes[ i ]->clear() ;
+	structureScore = 0. ;
+}
+
 float datastructures::BNStructure::getMeanInDegree(){
 	float indegree = 0. ;
 	for(int i = 0 ; i < variableCount ; i++) indegree += nodes[ i ]->getInGrade() ;
@@ -109,6 +153,21 @@ int datastructures::BNStructure::getMaxInDegree(){
 	return indegree ;
 }
 
+std::vector<int> datastructures::BNStructure::getOrder(){
+	std::vector<int> order ;
+	std::vector<int> missingParents( variableCount , 0 ) ;
+	for(int i = 0 ; i < variableCount ; i++)
+		missingParents[ i ] = nodes[ i ]->getInGrade() ;
+	for(int i = 0 ; i < variableCount ; i++)
+		if( missingParents[ i ] == 0 ) order.push_back( i ) ;
+	for(int k = 0 ; k < order.size() ; k++){
+		std::vector<int> children = nodes[ order[ k ] ]->getChildrenVector() ;
+		for(int j = 0 ; j < children.size() ; j++)
+			if( --missingParents[ children[ j ] ] == 0 ) order.push_back( children[ j ] ) ;
+	}
+	return order ;
+}
+
 structureoptimizer::Node* datastructures::BNStructure::operator[]( int index ){
 	return nodes[ index ] ;
 }
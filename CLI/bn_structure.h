@@ -21,6 +21,10 @@ namespace datastructures {
 						std::vector<bestscorecalculators::BestScoreCalculator*> &bsc ) ;
 			BNStructure( std::vector<bestscorecalculators::BestScoreCalculator*> &bsc ,
 							bool calculateEdgeWeights = false ) ;
+			BNStructure( const BNStructure &other ) ;
+			~BNStructure() ;
+
+			BNStructure& operator =( const BNStructure &other ) ;
 
 			structureoptimizer::Node* operator []( int index ) ;
 
@@ -30,14 +34,22 @@ namespace datastructures {
 
 			int size() ;
 
-			bool isBetter( datastructures::BNStructure other ) ;
+			bool isBetter( datastructures::BNStructure &other ) ;
 
 			void setParents( int indexnode , varset parents , float score ) ;
+			void clear() ; // Remove every edge and score
 
 			float getMeanInDegree() ;
 			int getMaxInDegree() ;
 
+			// A topological order of the variables, parents first
+			std::vector<int> getOrder() ;
+
 		private :
+			void copyNodes( const BNStructure &other ) ;
+			void deleteNodes() ;
+
+			// owned by the structure, copies get their own nodes
 			std::vector<structureoptimizer::Node*> nodes ;
 			float structureScore ;
 			int variableCount ;
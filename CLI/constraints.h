@@ -8,6 +8,7 @@
 #ifndef CONSTRAINTS_H
 #define	CONSTRAINTS_H
 
+#include <fstream>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
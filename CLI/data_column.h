@@ -0,0 +1,143 @@
+/*
+ * File:   data_column.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef DATA_COLUMN_H
+#define	DATA_COLUMN_H
+
+#include <stdint.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+namespace datastructures {
+
+	/**
+	 * One column of a data set, dictionary-encoded.
+	 *
+	 * Every distinct value gets an index in the order it is first seen, and the
+	 * column only keeps the index of each record. Indices are stored in one
+	 * byte while the column has at most 256 distinct values and are widened to
+	 * two bytes after that.
+	 */
+	class DataColumn {
+		public:
+
+			DataColumn() {
+				wide = false;
+			}
+
+			/**
+			 * Find the index of {@code value}, adding it to the dictionary if it
+			 * has not been seen before.
+			 *
+			 * @param value the value as it appears in the data file
+			 * @return the index of the value
+			 */
+			int encode(const std::string &value) {
+				auto it = valueToIndex.find(value);
+				if (it != valueToIndex.end()) {
+					return it->second;
+				}
+
+				int index = values.size();
+				if (index > UINT16_MAX) {
+					throw std::runtime_error("Too many distinct values in column.  Value: '" + value + "'");
+				}
+				if (index > UINT8_MAX && !wide) {
+					widen();
+				}
+
+				valueToIndex[value] = index;
+				values.push_back(value);
+				return index;
+			}
+
+			void push_back(int index) {
+				if (wide) {
+					wideValues.push_back(index);
+				} else {
+					narrowValues.push_back(index);
+				}
+			}
+
+			void push_back(const std::string &value) {
+				push_back(encode(value));
+			}
+
+			/**
+			 * Append the records of {@code other}, re-encoding its values.  The
+			 * values new to this column are added in the order they were first
+			 * seen in {@code other}.
+			 */
+			void append(const DataColumn &other) {
+				std::vector<int> indices(other.getCardinality());
+				for (int code = 0; code < other.getCardinality(); code++) {
+					indices[code] = encode(other.getValue(code));
+				}
+
+				int count = other.size();
+				if (wide) {
+					wideValues.reserve(wideValues.size() + count);
+				} else {
+					narrowValues.reserve(narrowValues.size() + count);
+				}
+				for (int record = 0; record < count; record++) {
+					push_back(indices[other.get(record)]);
+				}
+			}
+
+			uint16_t get(int record) const {
+				return wide ? wideValues[record] : narrowValues[record];
+			}
+
+			int size() const {
+				return wide ? wideValues.size() : narrowValues.size();
+			}
+
+			int getCardinality() const {
+				return values.size();
+			}
+
+			const std::string &getValue(int index) const {
+				return values[index];
+			}
+
+			const std::vector<std::string> &getValues() const {
+				return values;
+			}
+
+			bool isWide() const {
+				return wide;
+			}
+
+			const std::vector<uint8_t> &getNarrowValues() const {
+				return narrowValues;
+			}
+
+			const std::vector<uint16_t> &getWideValues() const {
+				return wideValues;
+			}
+
+		private:
+
+			void widen() {
+				wideValues.assign(narrowValues.begin(), narrowValues.end());
+				std::vector<uint8_t>().swap(narrowValues);
+				wide = true;
+			}
+
+			bool wide;
+			std::vector<uint8_t> narrowValues;
+			std::vector<uint16_t> wideValues;
+			std::vector<std::string> values;
+			boost::unordered_map<std::string, int> valueToIndex;
+	} ;
+}
+
+#endif	/* DATA_COLUMN_H */
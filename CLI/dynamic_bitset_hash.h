@@ -13,13 +13,18 @@
 #include <boost/functional/hash.hpp>
 #include <boost/dynamic_bitset.hpp>
 
+#include <boost/version.hpp>
+
 // make sure we can use dynamic_bitsets as values in the hash table
+// (boost >= 1.71 already ships this overload)
+#if BOOST_VERSION < 107100
 namespace boost {
 	template <typename B, typename A>
 	std::size_t hash_value(const boost::dynamic_bitset<B, A>& bs) {     
 		return boost::hash_value( bs.m_bits ) ;
 	}
 }
+#endif
 
 //template <typename B, typename A>
 struct hasher {
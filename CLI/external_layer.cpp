@@ -0,0 +1,263 @@
+/*
+ * File:   external_layer.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include "external_layer.h"
+
+parentselection::ExternalLayer::ExternalLayer(){
+	reset( 0 , 0 , "" ) ;
+}
+
+parentselection::ExternalLayer::~ExternalLayer(){
+	removeRuns() ;
+}
+
+void parentselection::ExternalLayer::reset( int variableCount , size_t memoryBudget , std::string filePrefix ){
+	this->variableCount = variableCount ;
+	this->wordCount = ( variableCount + 63 ) / 64 ;
+	this->filePrefix = filePrefix ;
+
+	// every entry takes its mask, the score, the count and its place in the order
+	size_t entrySize = wordCount * sizeof( uint64_t ) + sizeof( float ) + 2 * sizeof( int ) ;
+	this->maxBuffered = memoryBudget > 0 ? std::max( memoryBudget / entrySize , (size_t) 1 ) : 0 ;
+
+	clear() ;
+	// the buffer is spilled once full, so it never has to grow past the budget
+	masks.reserve( maxBuffered * wordCount ) ;
+	bestSubsetScores.reserve( maxBuffered ) ;
+	keptSubsets.reserve( maxBuffered ) ;
+	order.reserve( maxBuffered ) ;
+}
+
+void parentselection::ExternalLayer::clear(){
+	removeRuns() ;
+	masks.clear() ;
+	bestSubsetScores.clear() ;
+	keptSubsets.clear() ;
+	order.clear() ;
+	position = 0 ;
+	hasEntries = false ;
+}
+
+void parentselection::ExternalLayer::add( const varset &parents , float bestSubsetScore , bool kept ){
+	for(int word = 0 ; word < wordCount ; word++)
+		masks.push_back( varsetWord( parents , word ) ) ;
+	bestSubsetScores.push_back( bestSubsetScore ) ;
+	keptSubsets.push_back( kept ? 1 : 0 ) ;
+	hasEntries = true ;
+
+	if( maxBuffered > 0 && bestSubsetScores.size() >= maxBuffered ) spill() ;
+}
+
+void parentselection::ExternalLayer::finish(){
+	if( runFiles.empty() ){
+		sortBuffer() ;
+		position = 0 ;
+		return ;
+	}
+
+	// what is left in memory becomes the last run; the runs are merged in
+	// groups until they can all be open at once for the last merge
+	if( !bestSubsetScores.empty() ) spill() ;
+	while( runFiles.size() > MAX_MERGED_RUNS ){
+		int count = runFiles.size() ;
+		for(int first = 0 ; first < count ; first += MAX_MERGED_RUNS)
+			mergeRuns( first , std::min( first + MAX_MERGED_RUNS , count ) ) ;
+		runFiles.erase( runFiles.begin() , runFiles.begin() + count ) ;
+	}
+	openRuns( 0 , runFiles.size() ) ;
+}
+
+bool parentselection::ExternalLayer::next( varset &parents , float &bestSubsetScore , int &keptSubsets ){
+	std::vector<uint64_t> mask( wordCount ) ;
+	if( runFiles.empty() ){
+		if( position >= order.size() ) return false ;
+
+		// repeated sets are next to each other once sorted
+		int first = order[ position++ ] ;
+		std::copy( masks.begin() + first * wordCount , masks.begin() + ( first + 1 ) * wordCount , mask.begin() ) ;
+		bestSubsetScore = bestSubsetScores[ first ] ;
+		keptSubsets = this->keptSubsets[ first ] ;
+		while( position < order.size() && compareMasks( &masks[ order[ position ] * wordCount ] , &mask[ 0 ] ) == 0 ){
+			int k = order[ position++ ] ;
+			bestSubsetScore = std::max( bestSubsetScore , bestSubsetScores[ k ] ) ;
+			keptSubsets += this->keptSubsets[ k ] ;
+		}
+	}else if( !nextMerged( mask , bestSubsetScore , keptSubsets ) ){
+		removeRuns() ;
+		return false ;
+	}
+
+	VARSET_CLEAR_ALL( parents ) ;
+	for(int word = 0 ; word < wordCount ; word++){
+		uint64_t bits = mask[ word ] ;
+		while( bits ){
+			VARSET_SET( parents , 64 * word + __builtin_ctzll( bits ) ) ;
+			bits &= bits - 1 ;
+		}
+	}
+	return true ;
+}
+
+bool parentselection::ExternalLayer::empty() const {
+	return !hasEntries ;
+}
+
+int parentselection::ExternalLayer::getRunCount() const {
+	return runFiles.size() ;
+}
+
+int parentselection::ExternalLayer::compareMasks( const uint64_t *a , const uint64_t *b ) const {
+	for(int word = wordCount - 1 ; word >= 0 ; word--)
+		if( a[ word ] != b[ word ] ) return a[ word ] < b[ word ] ? -1 : 1 ;
+	return 0 ;
+}
+
+void parentselection::ExternalLayer::sortBuffer(){
+	order.resize( bestSubsetScores.size() ) ;
+	for(int i = 0 ; i < order.size() ; i++) order[ i ] = i ;
+	std::sort( order.begin() , order.end() , MaskLess( this ) ) ;
+}
+
+/**
+ * Write the entries in memory to a new run, sorted by mask and with the
+ * repeated ones combined, and empty the buffer.
+ */
+void parentselection::ExternalLayer::spill(){
+	sortBuffer() ;
+
+	FILE *file = createRun() ;
+	bool written = true ;
+	for(int i = 0 ; i < order.size() ; ){
+		int first = order[ i++ ] ;
+		float bestSubsetScore = bestSubsetScores[ first ] ;
+		int kept = keptSubsets[ first ] ;
+		while( i < order.size() && compareMasks( &masks[ order[ i ] * wordCount ] , &masks[ first * wordCount ] ) == 0 ){
+			bestSubsetScore = std::max( bestSubsetScore , bestSubsetScores[ order[ i ] ] ) ;
+			kept += keptSubsets[ order[ i ] ] ;
+			i++ ;
+		}
+		written = written && writeEntry( file , &masks[ first * wordCount ] , bestSubsetScore , kept ) ;
+	}
+	if( fclose( file ) != 0 || !written )
+		throw std::runtime_error( "Could not write the frontier file: '" + runFiles.back() + "'" ) ;
+
+	masks.clear() ;
+	bestSubsetScores.clear() ;
+	keptSubsets.clear() ;
+	order.clear() ;
+}
+
+// Open a new run for writing, listed so it is removed with the others
+FILE* parentselection::ExternalLayer::createRun(){
+	std::string filename = filePrefix + "." + TO_STRING( createdRuns++ ) ;
+	FILE *file = fopen( filename.c_str() , "wb" ) ;
+	if( file == NULL )
+		throw std::runtime_error( "Could not create the frontier file: '" + filename + "'" ) ;
+	runFiles.push_back( filename ) ;
+	return file ;
+}
+
+bool parentselection::ExternalLayer::writeEntry( FILE *file , const uint64_t *mask , float bestSubsetScore , int keptSubsets ){
+	return fwrite( mask , sizeof( uint64_t ) , wordCount , file ) == wordCount &&
+			fwrite( &bestSubsetScore , sizeof( float ) , 1 , file ) == 1 &&
+			fwrite( &keptSubsets , sizeof( int ) , 1 , file ) == 1 ;
+}
+
+/**
+ * Merge the runs [first, last) into a new one at the end of the list and
+ * remove their files.  A group of one run is only moved to the end.
+ */
+void parentselection::ExternalLayer::mergeRuns( int first , int last ){
+	if( last - first == 1 ){
+		runFiles.push_back( runFiles[ first ] ) ;
+		return ;
+	}
+
+	FILE *file = createRun() ;
+	openRuns( first , last ) ;
+	std::vector<uint64_t> mask( wordCount ) ;
+	float bestSubsetScore ;
+	int keptSubsets ;
+	bool written = true ;
+	while( nextMerged( mask , bestSubsetScore , keptSubsets ) )
+		written = written && writeEntry( file , &mask[ 0 ] , bestSubsetScore , keptSubsets ) ;
+	closeRuns() ;
+	if( fclose( file ) != 0 || !written )
+		throw std::runtime_error( "Could not write the frontier file: '" + runFiles.back() + "'" ) ;
+
+	for(int i = first ; i < last ; i++)
+		remove( runFiles[ i ].c_str() ) ;
+}
+
+void parentselection::ExternalLayer::openRuns( int first , int last ){
+	closeRuns() ;
+	Run closed ;
+	closed.file = NULL ;
+	runs.assign( last - first , closed ) ;
+	for(int i = 0 ; i < runs.size() ; i++){
+		runs[ i ].file = fopen( runFiles[ first + i ].c_str() , "rb" ) ;
+		if( runs[ i ].file == NULL )
+			throw std::runtime_error( "Could not open the frontier file: '" + runFiles[ first + i ] + "'" ) ;
+		runs[ i ].mask.resize( wordCount ) ;
+		if( readRun( runs[ i ] ) ){
+			heap.push_back( i ) ;
+			std::push_heap( heap.begin() , heap.end() , RunGreater( this ) ) ;
+		}
+	}
+}
+
+// Take the smallest mask from every open run which has it in front
+bool parentselection::ExternalLayer::nextMerged( std::vector<uint64_t> &mask , float &bestSubsetScore , int &keptSubsets ){
+	if( heap.empty() ) return false ;
+
+	bool found = false ;
+	while( !heap.empty() && ( !found || compareMasks( &runs[ heap.front() ].mask[ 0 ] , &mask[ 0 ] ) == 0 ) ){
+		std::pop_heap( heap.begin() , heap.end() , RunGreater( this ) ) ;
+		Run &run = runs[ heap.back() ] ;
+		if( !found ){
+			mask = run.mask ;
+			bestSubsetScore = run.bestSubsetScore ;
+			keptSubsets = run.keptSubsets ;
+			found = true ;
+		}else{
+			bestSubsetScore = std::max( bestSubsetScore , run.bestSubsetScore ) ;
+			keptSubsets += run.keptSubsets ;
+		}
+		if( readRun( run ) ){
+			std::push_heap( heap.begin() , heap.end() , RunGreater( this ) ) ;
+		}else{
+			heap.pop_back() ;
+		}
+	}
+	return true ;
+}
+
+bool parentselection::ExternalLayer::readRun( Run &run ){
+	if( fread( &run.mask[ 0 ] , sizeof( uint64_t ) , wordCount , run.file ) != wordCount ) return false ;
+	if( fread( &run.bestSubsetScore , sizeof( float ) , 1 , run.file ) != 1 ) return false ;
+	if( fread( &run.keptSubsets , sizeof( int ) , 1 , run.file ) != 1 ) return false ;
+	return true ;
+}
+
+void parentselection::ExternalLayer::closeRuns(){
+	for(int i = 0 ; i < runs.size() ; i++)
+		if( runs[ i ].file != NULL ) fclose( runs[ i ].file ) ;
+	runs.clear() ;
+	heap.clear() ;
+}
+
+void parentselection::ExternalLayer::removeRuns(){
+	closeRuns() ;
+	for(int i = 0 ; i < runFiles.size() ; i++)
+		remove( runFiles[ i ].c_str() ) ;
+	runFiles.clear() ;
+	createdRuns = 0 ;
+}
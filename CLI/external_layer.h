@@ -0,0 +1,112 @@
+/*
+ * File:   external_layer.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef EXTERNAL_LAYER_H
+#define	EXTERNAL_LAYER_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "typedefs.h"
+
+namespace parentselection {
+	/**
+	 * A layer of the breadth-first parent set search which may not fit in
+	 * memory.
+	 *
+	 * The parent sets are kept as packed masks of the bits in use, with the
+	 * best score of their subsets and how many of their immediate subsets
+	 * were kept.  Once the entries in memory pass the budget they are sorted
+	 * and written to disk as a run.  Reading merges the runs, so a set added
+	 * several times comes back once, with the best of the scores and the sum
+	 * of the counts, and no hash set is needed to find the duplicates.  At
+	 * most MAX_MERGED_RUNS runs are open at once; if there are more, they are
+	 * merged a group at a time into longer runs first.
+	 */
+	class ExternalLayer {
+		public :
+			ExternalLayer() ;
+			~ExternalLayer() ;
+
+			// Start an empty layer; a budget of 0 bytes keeps everything in memory
+			void reset( int variableCount , size_t memoryBudget , std::string filePrefix ) ;
+			void clear() ;
+
+			void add( const varset &parents , float bestSubsetScore , bool kept ) ;
+
+			// Stop adding and read the sets back, sorted and without repetitions
+			void finish() ;
+			bool next( varset &parents , float &bestSubsetScore , int &keptSubsets ) ;
+
+			bool empty() const ;
+			int getRunCount() const ;
+
+		private :
+			struct Run {
+				FILE *file ;
+				std::vector<uint64_t> mask ;
+				float bestSubsetScore ;
+				int keptSubsets ;
+			} ;
+
+			// orders the entries in memory by their masks
+			struct MaskLess {
+				MaskLess( const ExternalLayer *layer ) : layer( layer ) {}
+				bool operator()( int a , int b ) const {
+					const std::vector<uint64_t> &masks = layer->masks ;
+					return layer->compareMasks( &masks[ a * layer->wordCount ] , &masks[ b * layer->wordCount ] ) < 0 ;
+				}
+				const ExternalLayer *layer ;
+			} ;
+
+			// puts the run with the smallest mask on top of the heap
+			struct RunGreater {
+				RunGreater( const ExternalLayer *layer ) : layer( layer ) {}
+				bool operator()( int a , int b ) const {
+					return layer->compareMasks( &layer->runs[ a ].mask[ 0 ] , &layer->runs[ b ].mask[ 0 ] ) > 0 ;
+				}
+				const ExternalLayer *layer ;
+			} ;
+
+			static const int MAX_MERGED_RUNS = 64 ;
+
+			int compareMasks( const uint64_t *a , const uint64_t *b ) const ;
+			void sortBuffer() ;
+			void spill() ;
+			FILE* createRun() ;
+			bool writeEntry( FILE *file , const uint64_t *mask , float bestSubsetScore , int keptSubsets ) ;
+			void mergeRuns( int first , int last ) ;
+			void openRuns( int first , int last ) ;
+			bool nextMerged( std::vector<uint64_t> &mask , float &bestSubsetScore , int &keptSubsets ) ;
+			bool readRun( Run &run ) ;
+			void closeRuns() ;
+			void removeRuns() ;
+
+			int variableCount ;
+			int wordCount ;
+			size_t maxBuffered ;
+			std::string filePrefix ;
+
+			// the entries in memory, and their order once sorted
+			std::vector<uint64_t> masks ;
+			std::vector<float> bestSubsetScores ;
+			std::vector<int> keptSubsets ;
+			std::vector<int> order ;
+			int position ;
+
+			// the runs on disk, and the one with the smallest mask in front
+			std::vector<std::string> runFiles ;
+			int createdRuns ;
+			std::vector<Run> runs ;
+			std::vector<int> heap ;
+			bool hasEntries ;
+	} ;
+}
+
+#endif	/* EXTERNAL_LAYER_H */
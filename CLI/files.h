@@ -10,8 +10,13 @@
 
 #include <fstream>
 #include <iostream>
+#include <string.h>
+#include <stdint.h>
+#include <stdexcept>
 #include <boost/dynamic_bitset.hpp>
 
+#include "score_cache.h"
+
 inline std::string readString(std::ifstream& in) {
 	int length;
 	in.read((char*) &length, sizeof (length));
@@ -24,14 +29,11 @@ inline std::string readString(std::ifstream& in) {
 	return std::string(string);
 }
 
-inline void writeString(std::ofstream &out, std::string &s) {
-	int size = s.size();
-
-	out.write(reinterpret_cast <const char*>(size), sizeof(size));
+inline void writeInt(std::ofstream &out, int i);
 
-	for(int i = 0; i < size; i++) {
-		out.write(reinterpret_cast <const char*>(s[i]), sizeof(s[i]));
-	}
+inline void writeString(std::ofstream &out, const std::string &s) {
+	writeInt(out, s.size());
+	out.write(s.c_str(), s.size());
 }
 
 inline int readInt(std::ifstream& in) {
@@ -42,7 +44,8 @@ inline int readInt(std::ifstream& in) {
 }
 
 inline void writeInt(std::ofstream &out, int i) {
-	out.write(reinterpret_cast <const char*>(i), sizeof(i));
+	uint32_t value = htobe32(i);
+	out.write((char*) &value, sizeof(value));
 }
 
 inline char readByte(std::ifstream& in) {
@@ -52,7 +55,7 @@ inline char readByte(std::ifstream& in) {
 }
 
 inline void writeByte(std::ofstream &out, char c) {
-	out.write(reinterpret_cast <const char*>(c), sizeof(c));
+	out.write(&c, sizeof(c));
 }
 
 inline float readFloat(std::ifstream& in) {
@@ -70,7 +73,14 @@ inline float readFloat(std::ifstream& in) {
 }
 
 inline void writeFloat(std::ofstream &out, float f) {
-	out.write((char*)(&f), sizeof(f));
+	union {
+		float    f;
+		uint32_t i;
+	} val;
+
+	val.f = f;
+	val.i = htobe32(val.i);
+	out.write((char*) &val.i, sizeof(val.i));
 }
 
 inline uint64_t readLong(std::ifstream& in) {
@@ -81,7 +91,8 @@ inline uint64_t readLong(std::ifstream& in) {
 }
 
 inline void writeLong(std::ofstream &out, uint64_t l) {
-	out.write(reinterpret_cast <const char*>(l), sizeof(l));
+	uint64_t value = htobe64(l);
+	out.write((char*) &value, sizeof(value));
 }
 
 inline boost::dynamic_bitset<> readBitset(std::ifstream& in, int n) {
@@ -89,32 +100,122 @@ inline boost::dynamic_bitset<> readBitset(std::ifstream& in, int n) {
 	boost::dynamic_bitset<> value(n);
 
 	for(int i = 0; i < n; i++) {
-		value[i] = (val & 1<<i);
+		value[i] = (val & 1ULL<<i);
 	}
 
 	return value;
 }
 
+/*
+ * The same helpers for reading from a memory-mapped file.  Each one advances
+ * data past the value it read, and throws if the value does not end before
+ * end, so a truncated file is never read past its mapping.
+ */
+
+inline void checkAvailable(const char *data, const char *end, size_t size) {
+	if (data > end || (size_t) (end - data) < size) {
+		throw std::runtime_error("Unexpected end of the score cache file");
+	}
+}
+
+inline int readInt(const char *&data, const char *end) {
+	uint32_t value;
+	checkAvailable(data, end, sizeof (value));
+	memcpy(&value, data, sizeof (value));
+	data += sizeof (value);
+	return be32toh(value);
+}
+
+inline uint64_t readLong(const char *&data, const char *end) {
+	uint64_t value;
+	checkAvailable(data, end, sizeof (value));
+	memcpy(&value, data, sizeof (value));
+	data += sizeof (value);
+	return be64toh(value);
+}
+
+inline float readFloat(const char *&data, const char *end) {
+	union {
+		float    f;
+		uint32_t i;
+	} val;
+
+	checkAvailable(data, end, sizeof (val.i));
+	memcpy(&val.i, data, sizeof (val.i));
+	data += sizeof (val.i);
+	val.i = be32toh(val.i);
+	return val.f;
+}
+
+inline std::string readString(const char *&data, const char *end) {
+	int length = readInt(data, end);
+	if (length < 0) {
+		throw std::runtime_error("Invalid string length in the score cache file");
+	}
+	checkAvailable(data, end, length);
+	std::string value(data, length);
+	data += length;
+	return value;
+}
+
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 
 #include "bayesian_network.h"
 #include "variable.h"
-inline void concatenateScoreFiles( std::string outputFile , std::map<std::string,std::string> metadata ){
-	std::ofstream out( outputFile , std::ios_base::out | std::ios_base::binary ) ;
 
-	// first, the header information
-	std::string header = "META pss_version = 0.1\n" ;
-	header += "META input_file=" + metadata[ "datasetFile" ] + "\n" ;
-	header += "META num_variables=" + metadata[ "variableCount" ] + "\n" ;
-	header += "META num_records=" + metadata[ "numRecords" ] + "\n" ;
-	header += "META parent_limit=" + metadata[ "maxParents" ] + "\n" ;
-	header += "META score_type=" + metadata[ "scoringFunction" ] + "\n" ;
-	header += "META parent_selection=" + metadata[ "parentSelection" ] + "\n" ;
-	header += "\n" ;
-	out.write( header.c_str() , header.size() ) ;
+/*
+ * Binary score files.
+ *
+ * Everything is big-endian, as read by the helpers above.  The file starts
+ * with SCORE_FILE_MAGIC, the format version, the number of variables, the
+ * number of 64-bit words in each parent mask and the META key/value pairs.
+ * Then, for every variable, its name, arity and values are followed by the
+ * number of scores and the scores themselves, each one a packed parent mask
+ * and a float.  The scores of a variable are sorted by parent set size and
+ * then by mask.
+ */
+#define SCORE_FILE_MAGIC "BNSC"
+const int SCORE_FILE_MAGIC_LENGTH = 4 ;
+const int SCORE_FILE_VERSION = 1 ;
+
+inline int getMaskWordCount( int variableCount ){
+	return ( variableCount + 63 ) / 64 ;
+}
+
+inline void concatenateScoreFiles( std::string outputFile , std::map<std::string,std::string> metadata , std::string format ){
+	std::ofstream out( outputFile , std::ios_base::out | std::ios_base::binary ) ;
 
 	int variableCount ;
 	sscanf( metadata[ "variableCount" ].c_str() , "%d" , &variableCount ) ;
+
+	// first, the header information
+	if( format == "binary" ){
+		out.write( SCORE_FILE_MAGIC , SCORE_FILE_MAGIC_LENGTH ) ;
+		writeInt( out , SCORE_FILE_VERSION ) ;
+		writeInt( out , variableCount ) ;
+		writeInt( out , getMaskWordCount( variableCount ) ) ;
+
+		const char *keys[] = { "input_file" , "num_variables" , "num_records" , "parent_limit" , "score_type" , "parent_selection" } ;
+		const char *values[] = { "datasetFile" , "variableCount" , "numRecords" , "maxParents" , "scoringFunction" , "parentSelection" } ;
+		writeInt( out , 6 ) ;
+		for( int i = 0 ; i < 6 ; i++ ){
+			writeString( out , keys[ i ] ) ;
+			writeString( out , metadata[ values[ i ] ] ) ;
+		}
+	} else {
+		std::string header = "META pss_version = 0.1\n" ;
+		header += "META input_file=" + metadata[ "datasetFile" ] + "\n" ;
+		header += "META num_variables=" + metadata[ "variableCount" ] + "\n" ;
+		header += "META num_records=" + metadata[ "numRecords" ] + "\n" ;
+		header += "META parent_limit=" + metadata[ "maxParents" ] + "\n" ;
+		header += "META score_type=" + metadata[ "scoringFunction" ] + "\n" ;
+		header += "META parent_selection=" + metadata[ "parentSelection" ] + "\n" ;
+		header += "\n" ;
+		out.write( header.c_str() , header.size() ) ;
+	}
+
 	for( int variable = 0 ; variable < variableCount ; variable++){
 		std::string varFilename = outputFile + "." + TO_STRING( variable ) ;
 		std::ofstream varFile( varFilename , std::ios_base::in | std::ios_base::binary ) ;
@@ -129,7 +230,7 @@ inline void concatenateScoreFiles( std::string outputFile , std::map<std::string
 	out.close() ;
 }
 
-inline void createVariableScoreFile( std::string varFilename , datastructures::BayesianNetwork &network , int variable , FloatMap &sc ){
+inline void createTextVariableScoreFile( std::string varFilename , datastructures::BayesianNetwork &network , int variable , FloatMap &sc ){
 	FILE *varOut = fopen( varFilename.c_str() , "w" ) ;
 
 	datastructures::Variable *var = network.get( variable ) ;
@@ -160,4 +261,48 @@ inline void createVariableScoreFile( std::string varFilename , datastructures::B
 	fclose( varOut ) ;
 }
 
+inline void createBinaryVariableScoreFile( std::string varFilename , datastructures::BayesianNetwork &network , int variable , FloatMap &sc ){
+	std::ofstream out( varFilename , std::ios_base::out | std::ios_base::binary ) ;
+
+	datastructures::Variable *var = network.get( variable ) ;
+	writeString( out , var->getName() ) ;
+	writeInt( out , var->getCardinality() ) ;
+	writeInt( out , var->getCardinality() ) ;
+	for( int i = 0 ; i < var->getCardinality() ; i++)
+		writeString( out , var->getValue( i ) ) ;
+
+	// pack the parent sets, with the size first so they sort by size
+	int words = getMaskWordCount( network.size() ) ;
+	std::vector< std::pair< std::vector<uint64_t> , float > > scores ;
+	scores.reserve( sc.size() ) ;
+	for( auto score = sc.begin() ; score != sc.end() ; score++){
+		std::vector<uint64_t> mask( words + 1 , 0 ) ;
+		for( int p = 0 ; p < network.size() ; p++){
+			if( VARSET_GET( score->first , p ) ){
+				mask[ 0 ]++ ;
+				mask[ 1 + p / 64 ] |= 1ULL << ( p % 64 ) ;
+			}
+		}
+		scores.push_back( std::make_pair( mask , score->second ) ) ;
+	}
+	std::sort( scores.begin() , scores.end() ) ;
+
+	writeLong( out , scores.size() ) ;
+	for( auto score = scores.begin() ; score != scores.end() ; score++){
+		for( int w = 1 ; w <= words ; w++)
+			writeLong( out , score->first[ w ] ) ;
+		writeFloat( out , score->second ) ;
+	}
+
+	out.close() ;
+}
+
+inline void createVariableScoreFile( std::string varFilename , datastructures::BayesianNetwork &network , int variable , FloatMap &sc , std::string format ){
+	if( format == "binary" ){
+		createBinaryVariableScoreFile( varFilename , network , variable , sc ) ;
+	} else {
+		createTextVariableScoreFile( varFilename , network , variable , sc ) ;
+	}
+}
+
 #endif	/* FILES_H */
\ No newline at end of file
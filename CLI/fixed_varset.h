@@ -0,0 +1,327 @@
+/*
+ * File:   fixed_varset.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef FIXED_VARSET_H
+#define	FIXED_VARSET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <stdexcept>
+#include <string>
+
+#include <boost/functional/hash.hpp>
+#include <boost/lexical_cast.hpp>
+
+/**
+ * A set of variables stored in N bits held inline, so copying, hashing and
+ * subset tests never touch the heap.
+ *
+ * It offers the part of the boost::dynamic_bitset interface the varset
+ * macros rely on, with the same semantics: the set has a size chosen at
+ * construction, bits past the size are always zero, and only the words that
+ * cover the size are looked at.  A network of 40 variables therefore works
+ * on one word even if N is 512.  Hash values and ordering are the same as the
+ * ones of a dynamic_bitset of the same size, so hash maps keep the same
+ * iteration order whichever representation is used.
+ */
+template <int N>
+class FixedVarset {
+	static_assert(N == 64 || N == 128 || N == 256 || N == 512, "FixedVarset width must be 64, 128, 256 or 512");
+
+	public:
+		typedef size_t size_type;
+
+		static const size_type npos = static_cast<size_type>(-1);
+		static const int WORD_COUNT = N / 64;
+
+		FixedVarset() {
+			bits = 0;
+			clearWords(0);
+		}
+
+		explicit FixedVarset(size_type size, unsigned long value = 0) {
+			checkSize(size);
+			bits = size;
+			clearWords(0);
+			if (size > 0) {
+				words[0] = value;
+				clearUnusedBits();
+			}
+		}
+
+		size_type size() const {
+			return bits;
+		}
+
+		size_type num_blocks() const {
+			return (bits + 63) >> 6;
+		}
+
+		const uint64_t *getWords() const {
+			return words;
+		}
+
+		size_type count() const {
+			size_type result = 0;
+			for (size_type w = 0; w < num_blocks(); w++) {
+				result += __builtin_popcountll(words[w]);
+			}
+			return result;
+		}
+
+		bool none() const {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				if (words[w]) return false;
+			}
+			return true;
+		}
+
+		bool any() const {
+			return !none();
+		}
+
+		bool test(size_type index) const {
+			return (words[index >> 6] >> (index & 63)) & 1;
+		}
+
+		bool operator[](size_type index) const {
+			return test(index);
+		}
+
+		FixedVarset &set(size_type index, bool value = true) {
+			if (value) {
+				words[index >> 6] |= 1ULL << (index & 63);
+			} else {
+				words[index >> 6] &= ~(1ULL << (index & 63));
+			}
+			return *this;
+		}
+
+		FixedVarset &set() {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] = ~0ULL;
+			}
+			clearUnusedBits();
+			return *this;
+		}
+
+		FixedVarset &reset(size_type index) {
+			return set(index, false);
+		}
+
+		FixedVarset &reset() {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] = 0;
+			}
+			return *this;
+		}
+
+		FixedVarset &flip(size_type index) {
+			words[index >> 6] ^= 1ULL << (index & 63);
+			return *this;
+		}
+
+		FixedVarset &flip() {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] = ~words[w];
+			}
+			clearUnusedBits();
+			return *this;
+		}
+
+		void resize(size_type size, bool value = false) {
+			checkSize(size);
+			size_type old = bits;
+			if (size < old) {
+				bits = size;
+				clearUnusedBits();
+				clearWords(num_blocks());
+				return;
+			}
+
+			bits = size;
+			if (value) {
+				for (size_type index = old; index < size; index++) {
+					set(index);
+				}
+			}
+		}
+
+		size_type find_first() const {
+			return findFrom(0);
+		}
+
+		size_type find_next(size_type index) const {
+			return findFrom(index + 1);
+		}
+
+		bool is_subset_of(const FixedVarset &other) const {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				if (words[w] & ~other.words[w]) return false;
+			}
+			return true;
+		}
+
+		bool is_proper_subset_of(const FixedVarset &other) const {
+			return is_subset_of(other) && *this != other;
+		}
+
+		bool intersects(const FixedVarset &other) const {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				if (words[w] & other.words[w]) return true;
+			}
+			return false;
+		}
+
+		FixedVarset &operator&=(const FixedVarset &other) {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] &= other.words[w];
+			}
+			return *this;
+		}
+
+		FixedVarset &operator|=(const FixedVarset &other) {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] |= other.words[w];
+			}
+			return *this;
+		}
+
+		FixedVarset &operator^=(const FixedVarset &other) {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] ^= other.words[w];
+			}
+			return *this;
+		}
+
+		FixedVarset &operator-=(const FixedVarset &other) {
+			for (size_type w = 0; w < num_blocks(); w++) {
+				words[w] &= ~other.words[w];
+			}
+			return *this;
+		}
+
+		FixedVarset operator~() const {
+			FixedVarset result(*this);
+			return result.flip();
+		}
+
+		bool operator==(const FixedVarset &other) const {
+			if (bits != other.bits) return false;
+			for (size_type w = 0; w < num_blocks(); w++) {
+				if (words[w] != other.words[w]) return false;
+			}
+			return true;
+		}
+
+		bool operator!=(const FixedVarset &other) const {
+			return !(*this == other);
+		}
+
+		/**
+		 * Compare as dynamic_bitset does: sets of the same size compare as
+		 * numbers, otherwise bit by bit from the most significant one.
+		 */
+		bool operator<(const FixedVarset &other) const {
+			if (other.bits == 0) return false;
+			if (bits == 0) return true;
+
+			if (bits == other.bits) {
+				for (size_type w = num_blocks(); w > 0; w--) {
+					if (words[w - 1] != other.words[w - 1]) {
+						return words[w - 1] < other.words[w - 1];
+					}
+				}
+				return false;
+			}
+
+			size_type a = bits, b = other.bits;
+			for (; a > 0 && b > 0; a--, b--) {
+				if (test(a - 1) != other.test(b - 1)) {
+					return other.test(b - 1);
+				}
+			}
+			return bits < other.bits;
+		}
+
+		friend size_t hash_value(const FixedVarset &vs) {
+			size_t blocks = 0;
+			for (size_type w = 0; w < vs.num_blocks(); w++) {
+				boost::hash_combine(blocks, vs.words[w]);
+			}
+
+			size_t result = vs.bits;
+			boost::hash_combine(result, blocks);
+			return result;
+		}
+
+	private:
+
+		void checkSize(size_type size) const {
+			if (size > (size_type) N) {
+				int width = 64;
+				while ((size_type) width < size) width *= 2;
+				throw std::runtime_error("Variable sets are limited to " + boost::lexical_cast<std::string>(N) +
+						" variables.  Rebuild with -DVARSET_WIDTH=" + boost::lexical_cast<std::string>(width) +
+						" to use " + boost::lexical_cast<std::string>(size) + " variables.");
+			}
+		}
+
+		void clearWords(size_type first) {
+			for (int w = first; w < WORD_COUNT; w++) {
+				words[w] = 0;
+			}
+		}
+
+		void clearUnusedBits() {
+			if (bits & 63) {
+				words[bits >> 6] &= (1ULL << (bits & 63)) - 1;
+			}
+		}
+
+		size_type findFrom(size_type index) const {
+			if (index >= bits) return npos;
+
+			size_type w = index >> 6;
+			uint64_t word = words[w] & (~0ULL << (index & 63));
+			while (true) {
+				if (word) return (w << 6) + __builtin_ctzll(word);
+				if (++w >= num_blocks()) return npos;
+				word = words[w];
+			}
+		}
+
+		uint64_t words[WORD_COUNT];
+		uint32_t bits;
+} ;
+
+template <int N>
+inline FixedVarset<N> operator&(const FixedVarset<N> &a, const FixedVarset<N> &b) {
+	FixedVarset<N> result(a);
+	return result &= b;
+}
+
+template <int N>
+inline FixedVarset<N> operator|(const FixedVarset<N> &a, const FixedVarset<N> &b) {
+	FixedVarset<N> result(a);
+	return result |= b;
+}
+
+template <int N>
+inline FixedVarset<N> operator^(const FixedVarset<N> &a, const FixedVarset<N> &b) {
+	FixedVarset<N> result(a);
+	return result ^= b;
+}
+
+template <int N>
+inline FixedVarset<N> operator-(const FixedVarset<N> &a, const FixedVarset<N> &b) {
+	FixedVarset<N> result(a);
+	return result -= b;
+}
+
+#endif	/* FIXED_VARSET_H */
@@ -0,0 +1,200 @@
+/*
+ * File:   flat_ad_tree.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include "flat_ad_tree.h"
+#include "variable.h"
+
+const uint32_t scoring::FlatADTree::NO_CHILD;
+
+scoring::FlatADTree::FlatADTree(int rMin) : ADTree(rMin) {
+	// do nothing
+}
+
+scoring::FlatADTree::~FlatADTree() {
+	// no pointers
+}
+
+void scoring::FlatADTree::initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile) {
+	this->network = network;
+	this->recordCount = recordFile.size();
+	VARSET_NEW(empty, network.size());
+	zero = empty;
+
+	// keep the value index of every record, one column per variable
+	columns = network.getValueColumns(recordFile);
+}
+
+void scoring::FlatADTree::createTree() {
+	nodes.clear();
+	varyNodes.clear();
+	children.clear();
+	leafRecords.clear();
+
+	std::vector<uint32_t> recordNums(recordCount);
+	for (int index = 0; index < recordCount; index++) {
+		recordNums[index] = index;
+	}
+	makeADTree(0, recordNums);
+
+	// the arrays only grow while building
+	nodes.shrink_to_fit();
+	varyNodes.shrink_to_fit();
+	children.shrink_to_fit();
+	leafRecords.shrink_to_fit();
+}
+
+uint32_t scoring::FlatADTree::makeADTree(int i, std::vector<uint32_t> &recordNums) {
+	uint32_t nodeIndex = nodes.size();
+	Node node;
+	node.count = recordNums.size();
+	node.first = 0;
+	nodes.push_back(node);
+
+	// check if we should just use a leaf list
+	if (isLeaf(nodeIndex)) {
+		nodes[nodeIndex].first = leafRecords.size();
+		leafRecords.insert(leafRecords.end(), recordNums.begin(), recordNums.end());
+		return nodeIndex;
+	}
+
+	// reserve one contiguous vary node for each of the remaining variables
+	uint32_t firstVary = varyNodes.size();
+	nodes[nodeIndex].first = firstVary;
+	varyNodes.resize(firstVary + network.size() - i);
+
+	for (int j = i; j < network.size(); j++) {
+		makeVaryNode(firstVary + j - i, j, recordNums);
+	}
+
+	return nodeIndex;
+}
+
+void scoring::FlatADTree::makeVaryNode(uint32_t varyIndex, int i, std::vector<uint32_t> &recordNums) {
+	int cardinality = network.getCardinality(i);
+
+	uint32_t firstChild = children.size();
+	children.resize(firstChild + cardinality, NO_CHILD);
+	varyNodes[varyIndex].first = firstChild;
+
+	// split into childNums
+	std::vector< std::vector<uint32_t> > childNums(cardinality);
+	const std::vector<uint16_t> &column = columns[i];
+	for (auto r = recordNums.begin(); r != recordNums.end(); r++) {
+		childNums[column[*r]].push_back(*r);
+	}
+
+	int mcv = -1;
+	int mcvCount = -1;
+	for (int k = 0; k < cardinality; k++) {
+		int count = childNums[k].size();
+		if (count > mcvCount) {
+			mcv = k;
+			mcvCount = count;
+		}
+	}
+
+	// update the mcv
+	varyNodes[varyIndex].mcv = mcv;
+
+	// otherwise, recurse
+	for (int k = 0; k < cardinality; k++) {
+		if (k == mcv || childNums[k].size() == 0) {
+			continue;
+		}
+
+		uint32_t child = makeADTree(i + 1, childNums[k]);
+		children[firstChild + k] = child;
+
+		// release the partition as soon as its subtree is built
+		std::vector<uint32_t>().swap(childNums[k]);
+	}
+}
+
+scoring::ContingencyTableNode* scoring::FlatADTree::makeContab(varset variables) {
+	if (isLeaf(0)) {
+		return makeContabLeafList(variables, &leafRecords[0], nodes[0].count);
+	}
+	return makeContab(variables, 0, -1);
+}
+
+scoring::ContingencyTableNode* scoring::FlatADTree::makeContab(varset &remainingVariables, uint32_t nodeIndex, int variableIndex) {
+	// check base case
+	if (remainingVariables == zero) {
+		ContingencyTableNode *ctn = new ContingencyTableNode(nodes[nodeIndex].count, 0, 1);
+		return ctn;
+	}
+
+	int firstIndex = VARSET_FIND_FIRST_SET(remainingVariables); // first set bit
+	int n = network.getCardinality(firstIndex);
+	Vary vn = varyNodes[nodes[nodeIndex].first + firstIndex - variableIndex - 1];
+	ContingencyTableNode *ct = new ContingencyTableNode(0, n, 0);
+	varset newVariables = varsetClearCopy(remainingVariables, firstIndex);
+
+	ContingencyTableNode *ctMcv = makeContab(newVariables, nodeIndex, variableIndex);
+
+	for (int k = 0; k < n; k++) {
+		uint32_t child = children[vn.first + k];
+		if (child == NO_CHILD) { // also finds mcv
+			continue;
+		}
+
+		ContingencyTableNode *childTable = NULL;
+		if (isLeaf(child)) {
+			childTable = makeContabLeafList(newVariables, &leafRecords[nodes[child].first], nodes[child].count);
+		} else {
+			childTable = makeContab(newVariables, child, firstIndex);
+		}
+
+		ct->setChild(k, childTable);
+		ct->leafCount += childTable->leafCount;
+
+		ctMcv->subtract(childTable);
+	}
+	ct->setChild(vn.mcv, ctMcv);
+	ct->leafCount += ctMcv->leafCount;
+
+	return ct;
+}
+
+scoring::ContingencyTableNode* scoring::FlatADTree::makeContabLeafList(varset &variables, const uint32_t *records, uint32_t count) {
+	if (variables == zero) {
+		ContingencyTableNode *ct = new ContingencyTableNode(count, 0, 1);
+		return ct;
+	}
+
+	int firstIndex = VARSET_FIND_FIRST_SET(variables); // first set bit
+	int cardinality = network.getCardinality(firstIndex);
+	ContingencyTableNode *ct = new ContingencyTableNode(0, cardinality, 0);
+	varset remainingVariables = varsetClearCopy(variables, firstIndex);
+
+	// counting sort of the records on the value of firstIndex
+	const std::vector<uint16_t> &column = columns[firstIndex];
+	std::vector<uint32_t> offsets(cardinality + 1, 0);
+	for (uint32_t r = 0; r < count; r++) {
+		offsets[column[records[r]] + 1]++;
+	}
+	for (int k = 0; k < cardinality; k++) {
+		offsets[k + 1] += offsets[k];
+	}
+
+	std::vector<uint32_t> sorted(count);
+	std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+	for (uint32_t r = 0; r < count; r++) {
+		sorted[next[column[records[r]]]++] = records[r];
+	}
+
+	for (int k = 0; k < cardinality; k++) {
+		uint32_t size = offsets[k + 1] - offsets[k];
+		if (size > 0) {
+			ContingencyTableNode *child = makeContabLeafList(remainingVariables, &sorted[offsets[k]], size);
+			ct->setChild(k, child);
+			ct->leafCount += child->leafCount;
+		}
+	}
+
+	return ct;
+}
@@ -0,0 +1,76 @@
+/*
+ * File:   flat_ad_tree.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef FLAT_AD_TREE_H
+#define	FLAT_AD_TREE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ad_tree.h"
+#include "bayesian_network.h"
+#include "contingency_table_node.h"
+#include "record_file.h"
+#include "typedefs.h"
+
+namespace scoring {
+
+	/**
+	 * An AD-tree which keeps all of its nodes in contiguous arrays instead of
+	 * allocating each ADNode and VaryNode on the heap.
+	 *
+	 * Nodes refer to their children by 32-bit offsets into those arrays, and
+	 * leaf lists are stored as runs of record indices instead of bitsets over
+	 * the whole data set. The contingency tables it builds are the same as the
+	 * ones built by ADTree, so it can be used anywhere an ADTree is expected.
+	 */
+	class FlatADTree : public ADTree {
+		public:
+			FlatADTree(int rMin);
+			~FlatADTree();
+
+			void initialize(datastructures::BayesianNetwork &network, datastructures::RecordFile &recordFile);
+			void createTree();
+
+			ContingencyTableNode* makeContab(varset variables);
+
+		private:
+			static const uint32_t NO_CHILD = 0xFFFFFFFF;
+
+			// for inner nodes, first is the offset of the first vary node;
+			// for leaves (count < rMin), it is the offset of the first record
+			struct Node {
+				uint32_t count;
+				uint32_t first;
+			};
+
+			// the children of a vary node are stored in children[first, first + cardinality)
+			struct Vary {
+				uint32_t first;
+				int32_t mcv;
+			};
+
+			uint32_t makeADTree(int i, std::vector<uint32_t> &recordNums);
+			void makeVaryNode(uint32_t varyIndex, int i, std::vector<uint32_t> &recordNums);
+
+			ContingencyTableNode* makeContab(varset &remainingVariables, uint32_t nodeIndex, int variableIndex);
+			ContingencyTableNode* makeContabLeafList(varset &variables, const uint32_t *records, uint32_t count);
+
+			bool isLeaf(uint32_t nodeIndex) {
+				return (int) nodes[nodeIndex].count < rMin;
+			}
+
+			std::vector< std::vector<uint16_t> > columns;
+
+			std::vector<Node> nodes;
+			std::vector<Vary> varyNodes;
+			std::vector<uint32_t> children;
+			std::vector<uint32_t> leafRecords;
+	} ;
+}
+
+#endif	/* FLAT_AD_TREE_H */
@@ -33,54 +33,136 @@ namespace structureoptimizer {
 					permutation.push_back( i ) ;
 				permutation = shuffle( permutation , gen ) ;
 				this->bestScoreCalculator = bestScoreCalculator ;
-				structure = new datastructures::BNStructure( size ) ;
 				updateScore() ;
 			}
 
 			PermutationSet* clone() {
-				GreedyBehaviorSet* set ;
-				set = new GreedyBehaviorSet( permutation.size() , bestScoreCalculator ) ;
-				set->setPermutation( getPermutation() ) ;
+				// the scores of every position are copied, nothing is rescored
+				GreedyBehaviorSet* set = new GreedyBehaviorSet( *this ) ;
+				set->sumScores() ;
 				return set ;
 			}
 			
+			// Like clone, the scores of every position are summed again
+			void copyFrom( const PermutationSet &other ){
+				PermutationSet::copyFrom( other ) ;
+				sumScores() ;
+			}
+
+			// Built from the order on every call, the set keeps the last one
 			datastructures::BNStructure* getStructure(){
+				delete structure ;
 				structure = new datastructures::BNStructure( this , bestScoreCalculator ) ;
 				return structure ;
 			}
 			
+			float evaluateSwap( int idx ){
+				if( parentIndices.size() != size() ) return PermutationSet::evaluateSwap( idx ) ;
+				int firstIndex , secondIndex ;
+				float firstScore , secondScore ;
+				return adjacentScore( idx , permutation[ idx ] , permutation[ idx + 1 ] , neighbourPrefix ,
+										firstIndex , firstScore , secondIndex , secondScore ) ;
+			}
+
+			void applySwap( int idx ){
+				undoScore = getScore() ;
+				undoIndices[ 0 ] = parentIndices[ idx ] ;
+				undoIndices[ 1 ] = parentIndices[ idx + 1 ] ;
+				undoScores[ 0 ] = positionScores[ idx ] ;
+				undoScores[ 1 ] = positionScores[ idx + 1 ] ;
+				swap( idx , idx + 1 ) ;
+				sumScores() ;
+			}
+
+			void undoSwap( int idx ){
+				std::swap( permutation[ idx ] , permutation[ idx + 1 ] ) ;
+				parentIndices[ idx ] = undoIndices[ 0 ] ;
+				parentIndices[ idx + 1 ] = undoIndices[ 1 ] ;
+				positionScores[ idx ] = undoScores[ 0 ] ;
+				positionScores[ idx + 1 ] = undoScores[ 1 ] ;
+				prefixes[ idx + 1 ] = prefixes[ idx ] ;
+				VARSET_SET( prefixes[ idx + 1 ] , permutation[ idx ] ) ;
+				setScore( undoScore ) ;
+			}
+
 		private :
+			// Summing the scores of every position again in order gives the
+			// score of a full update, without the rounding of adjacent moves
+			void sumScores(){
+				float newScore = 0.0 ;
+				for(int i = 0 ; i < size() ; i++)
+					newScore += positionScores[ i ] ;
+				setScore( newScore ) ;
+			}
+
 			void updateScore( int adjacentPos = -1 ){
-				if( adjacentPos < 0 ){ // Not adjacent move
+				if( adjacentPos < 0 || parentIndices.size() != size() ){ // Not adjacent move
+					parentIndices.assign( size() , -1 ) ;
+					positionScores.assign( size() , 0 ) ;
+					prefixes.resize( size() ) ;
+					neighbourPrefix = VARSET( permutation.size() ) ;
 					float newScore = 0.0 ;
+					VARSET_NEW( options , permutation.size() ) ;
+					VARSET_CLEAR_ALL( options ) ;
 					for(int i = 0 ; i < size() ; i++){
-						varset options = getVarset( i ) ;
 						int variable = permutation[ i ] ;
-						newScore += bestScoreCalculator[ variable ]->getScore( options ) ;
+						prefixes[ i ] = options ;
+						positionScores[ i ] = bestScoreCalculator[ variable ]->getScore( prefixes[ i ] , parentIndices[ i ] ) ;
+						newScore += positionScores[ i ] ;
+						VARSET_SET( options , variable ) ;
 					}
 					setScore( newScore ) ;
 				}else{ // Adjacent move in "adjacentPos"
-					VARSET_NEW( vset , permutation.size() ) ;
-					VARSET_CLEAR_ALL( vset ) ;
-					for( int i = 0 ; i < adjacentPos ; i++)
-						VARSET_SET( vset , permutation[ i ] ) ;
-					float newScore = getScore() ;
-
-					// TODO: Add an if in case P[ adj + 1 ] was not a parent of P[ adj ] before swap
-					// Remove previous scores
-					newScore -= bestScoreCalculator[ permutation[ adjacentPos + 1 ] ]->getScore( vset ) ;
-					VARSET_SET( vset , permutation[ adjacentPos + 1 ] ) ;
-					newScore -= bestScoreCalculator[ permutation[ adjacentPos ] ]->getScore( vset ) ;
-
-					// Add current scores
-					VARSET_CLEAR( vset , permutation[ adjacentPos + 1 ] ) ;
-					newScore += bestScoreCalculator[ permutation[ adjacentPos ] ]->getScore( vset ) ;
-					VARSET_SET( vset , permutation[ adjacentPos ] ) ;
-					newScore += bestScoreCalculator[ permutation[ adjacentPos + 1 ] ]->getScore( vset ) ;
+					// the variables were already swapped: "first" moved back
+					// from adjacentPos and "second" moved forward to it
+					int first = permutation[ adjacentPos + 1 ] ;
+					int second = permutation[ adjacentPos ] ;
+					int firstIndex , secondIndex ;
+					float firstScore , secondScore ;
+					float newScore = adjacentScore( adjacentPos , first , second , prefixes[ adjacentPos + 1 ] ,
+													firstIndex , firstScore , secondIndex , secondScore ) ;
+
+					parentIndices[ adjacentPos ] = secondIndex ;
+					positionScores[ adjacentPos ] = secondScore ;
+					parentIndices[ adjacentPos + 1 ] = firstIndex ;
+					positionScores[ adjacentPos + 1 ] = firstScore ;
 
 					setScore( newScore ) ;
 				}
 			}
+
+			/**
+			 * The score once "first" moves back from pos to pos + 1 and "second"
+			 * moves forward from pos + 1 to pos, from the stored state before the
+			 * move.  "between" gets the variables before pos + 1 after the move
+			 * and the new indices and scores of both variables are returned.
+			 */
+			float adjacentScore( int pos , int first , int second , varset &between ,
+									int &firstIndex , float &firstScore , int &secondIndex , float &secondScore ){
+				float newScore = getScore() ;
+
+				// Remove previous scores
+				newScore -= positionScores[ pos ] ;
+				newScore -= positionScores[ pos + 1 ] ;
+
+				// Add current scores; "second" lost "first" as a possible
+				// parent and "first" gained "second"
+				secondIndex = parentIndices[ pos + 1 ] ;
+				secondScore = bestScoreCalculator[ second ]->getScoreRemoving( prefixes[ pos ] , first , secondIndex ) ;
+				newScore += secondScore ;
+				between = prefixes[ pos ] ;
+				VARSET_SET( between , second ) ;
+				firstIndex = parentIndices[ pos ] ;
+				firstScore = bestScoreCalculator[ first ]->getScoreAdding( between , second , firstIndex ) ;
+				newScore += firstScore ;
+				return newScore ;
+			}
+
+			// scratch prefix for evaluateSwap and the state applySwap replaced
+			varset neighbourPrefix ;
+			float undoScore ;
+			int undoIndices[ 2 ] ;
+			float undoScores[ 2 ] ;
 	} ;
 }
 
@@ -13,7 +13,7 @@
 #include "utils.h"
 
 structureoptimizer::GreedySearch::GreedySearch(){
-	// Do nothing
+	this->evaluator = NULL ;
 }
 
 structureoptimizer::GreedySearch::GreedySearch( initializers::Initializer* initializer ,
@@ -25,16 +25,18 @@ structureoptimizer::GreedySearch::GreedySearch( initializers::Initializer* initi
 	this->gen = boost::mt19937( time( NULL ) ) ;
 	
 	setParameters( parametersFile ) ;
+	this->evaluator = new NeighbourhoodEvaluator( this->bestScoreCalculators , threadCount ) ;
 }
 
 structureoptimizer::GreedySearch::~GreedySearch(){
-	// Do nothing
+	delete evaluator ;
 }
 
 void structureoptimizer::GreedySearch::setDefaultParameters(){
 	this->performSolutionPerturbation = true ;
 	this->numPerturbationSwaps = 3 ;
 	this->maxIterations = 500 ;
+	this->threadCount = 1 ;
 }
 
 void structureoptimizer::GreedySearch::setFileParameters( std::map<std::string,std::string> params ){
@@ -49,6 +51,9 @@ void structureoptimizer::GreedySearch::setFileParameters( std::map<std::string,s
 	
 	if( params.count( "max_iterations" ) )
 		sscanf( params[ "max_iterations" ].c_str() , "%d" , &maxIterations ) ;
+
+	if( params.count( "threads" ) )
+		sscanf( params[ "threads" ].c_str() , "%d" , &threadCount ) ;
 }
 
 void structureoptimizer::GreedySearch::printParameters(){
@@ -56,6 +61,7 @@ void structureoptimizer::GreedySearch::printParameters(){
 	printf( "Perturb solutions: %s\n" , performSolutionPerturbation ? "true" : "false" ) ;
 	if( performSolutionPerturbation )
 		printf( "Num. of perturbation swaps: %d\n" , numPerturbationSwaps ) ;
+	printf( "Threads: %d\n" , evaluator->getThreadCount() ) ;
 }
 
 void structureoptimizer::GreedySearch::initialize(){
@@ -72,10 +78,15 @@ datastructures::BNStructure structureoptimizer::GreedySearch::search_internal(){
 	for(int i = 0 ; i < maxIterations && !outOfTime ; i++){
 		structureoptimizer::PermutationSet* bestNeighbour = findBestNeighbour( current ) ;
 		structureoptimizer::PermutationSet* disturbedNeighbour = perturbSet( bestNeighbour ) ;
-		if( disturbedNeighbour->isBetter( *bestNeighbour ) ) bestNeighbour = disturbedNeighbour->clone() ;
-		if( !bestNeighbour->isBetter( *current ) ) break ;
+		if( disturbedNeighbour->isBetter( *bestNeighbour ) ) std::swap( bestNeighbour , disturbedNeighbour ) ;
+		delete disturbedNeighbour ;
+		if( !bestNeighbour->isBetter( *current ) ){
+			delete bestNeighbour ;
+			break ;
+		}
 		printf(" === Iteration %d ===\n" , i+1 ) ;
-		current = bestNeighbour->clone() ;
+		delete current ;
+		current = bestNeighbour ;
 		current->print() ;
 		numIterations += 1 ;
 	}
@@ -85,13 +96,10 @@ datastructures::BNStructure structureoptimizer::GreedySearch::search_internal(){
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::GreedySearch::findBestNeighbour( structureoptimizer::PermutationSet* set ){
-	structureoptimizer::PermutationSet* bestN = set->clone() ;
-	for(int i = 0 ; i < variableCount - 1 ; i++){
-		structureoptimizer::PermutationSet* neighbour = doSwap( set , i ) ;
-		if( !neighbour->isBetter( *bestN ) ) continue ;
-		bestN = neighbour->clone() ;
-	}
-	return bestN ;
+	// Only score the neighbours, the best one is built at the end
+	int bestSwap = evaluator->findBestSwap( set ) ;
+	if( bestSwap < 0 ) return set->clone() ;
+	return doSwap( set , bestSwap ) ;
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::GreedySearch::perturbSet( structureoptimizer::PermutationSet* set ){
@@ -109,6 +117,6 @@ structureoptimizer::PermutationSet* structureoptimizer::GreedySearch::perturbSet
 
 structureoptimizer::PermutationSet* structureoptimizer::GreedySearch::doSwap( structureoptimizer::PermutationSet* set , int index ){
 	structureoptimizer::PermutationSet* newSet = set->clone();
-	newSet->swap( index , index + 1 ) ;
+	newSet->applySwap( index ) ;
 	return newSet ;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <string>
 
 #include "structure_optimizer.h"
+#include "neighbourhood_evaluator.h"
 #include "permutation_set.h"
 
 namespace structureoptimizer {
@@ -36,11 +37,13 @@ namespace structureoptimizer {
 			void setFileParameters( std::map<std::string,std::string> params ) ;
 
 			PermutationSet* current ;
+			NeighbourhoodEvaluator* evaluator ;
 
 			// Configurable Parameters
 			int maxIterations ;
 			int numPerturbationSwaps ;
 			bool performSolutionPerturbation ;
+			int threadCount ;
 	} ;
 }
 
@@ -32,6 +32,7 @@ void parentselection::GreedySelection::calculateScores_internal( int variable ,
 		VARSET_NEW( best , variableCount ) ;
 		best = node.first ;
 		if( cardinality( best ) >= maxParents ) continue ;
+		if( !scoringFunction->canImproveSupersets( variable , best , node.second ) ) continue ;
 		VARSET_NEW( superset , variableCount ) ;
 		superset = best ;
 		for(int i = 0 ; i < options.size() && !outOfTime ; i++){
@@ -8,6 +8,8 @@
 #ifndef GREEDY_SELECTION_H
 #define	GREEDY_SELECTION_H
 
+#include <queue>
+
 #include "parent_set_selection.h"
 #include "utils.h"
 
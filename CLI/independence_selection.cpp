@@ -44,6 +44,7 @@ void parentselection::IndependenceSelection::calculateScores_internal( int varia
 		}
 
 		if( cardinality( parents ) >= maxParents ) continue ;
+		if( compare( score ) < 0 && !scoringFunction->canImproveSupersets( variable , parents , score ) ) continue ;
 
 		// Expand parent set
 		VARSET_NEW( superset , variableCount ) ;
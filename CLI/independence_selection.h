@@ -8,6 +8,8 @@
 #ifndef INDEPENDENCE_SELECTION_H
 #define	INDEPENDENCE_SELECTION_H
 
+#include <queue>
+
 #include "parent_set_selection.h"
 #include "utils.h"
 
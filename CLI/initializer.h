@@ -15,8 +15,15 @@
 namespace initializers {
 	class Initializer {
 		public :
+			virtual ~Initializer(){}
+
 			virtual structureoptimizer::PermutationSet* generate( int setType = 0 ) = 0 ;
 			virtual void initialize() = 0 ;
+
+			template <typename SeedSeq>
+			void setSeed( SeedSeq &seed ){
+				gen.seed( seed ) ;
+			}
 			
 		protected :
 			int variableCount ;
@@ -0,0 +1,211 @@
+/*
+ * File:   island_search.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include <boost/thread.hpp>
+
+#include "island_search.h"
+#include "structure_optimizer_creator.h"
+#include "permutation_set_creator.h"
+#include "utils.h"
+
+structureoptimizer::IslandSearch::IslandSearch(){
+	this->mailbox = NULL ;
+}
+
+structureoptimizer::IslandSearch::IslandSearch( initializers::Initializer* initializer ,
+										std::vector<bestscorecalculators::BestScoreCalculator*> bestScoreCalculator ,
+										std::string parametersFile ){
+	this->initializer = initializer ;
+	this->bestScoreCalculators = bestScoreCalculator ;
+	this->variableCount = bestScoreCalculator.size() ;
+	this->gen = boost::mt19937( time( NULL ) ) ;
+
+	setParameters( parametersFile ) ;
+	if( algorithm == "island_search" )
+		throw std::runtime_error( "Invalid algorithm for the islands: 'island_search'" ) ;
+	if( islandCount < 1 ) islandCount = 1 ;
+
+	// the islands share the calculators, so they only run at the same time if they allow it
+	this->concurrent = true ;
+	for(int i = 0 ; i < bestScoreCalculators.size() ; i++)
+		if( !bestScoreCalculators[ i ]->isConcurrent() ) concurrent = false ;
+
+	for(int i = 0 ; i < islandCount ; i++){
+		initializers::OrderInitializer* islandInitializer = new initializers::OrderInitializer( bestScoreCalculators ) ;
+		islandInitializers.push_back( islandInitializer ) ;
+		islands.push_back( structureoptimizer::create( algorithm , islandInitializer , bestScoreCalculators , algorithmParametersFile ) ) ;
+	}
+	this->islandGens.resize( islandCount ) ;
+	this->startOrders.resize( islandCount ) ;
+	this->bestOrders.resize( islandCount ) ;
+	this->bestScores.resize( islandCount ) ;
+	this->published.resize( islandCount ) ;
+	this->mailbox = new boost::atomic<Migrant*>[ islandCount ] ;
+	for(int i = 0 ; i < islandCount ; i++) mailbox[ i ] = NULL ;
+}
+
+structureoptimizer::IslandSearch::~IslandSearch(){
+	for(int i = 0 ; i < islands.size() ; i++){
+		delete islands[ i ] ;
+		delete islandInitializers[ i ] ;
+		for(int j = 0 ; j < published[ i ].size() ; j++) delete published[ i ][ j ] ;
+	}
+	delete [] mailbox ;
+}
+
+void structureoptimizer::IslandSearch::setDefaultParameters(){
+	this->algorithm = "greedy_search" ;
+	this->algorithmParametersFile = "" ;
+	this->islandCount = 4 ;
+	this->maxEpochs = 10 ;
+	this->numMigrationSwaps = 3 ;
+}
+
+void structureoptimizer::IslandSearch::setFileParameters( std::map<std::string,std::string> params ){
+	if( params.count( "algorithm" ) )
+		algorithm = params[ "algorithm" ] ;
+
+	if( params.count( "algorithm_params" ) )
+		algorithmParametersFile = params[ "algorithm_params" ] ;
+
+	if( params.count( "islands" ) )
+		sscanf( params[ "islands" ].c_str() , "%d" , &islandCount ) ;
+
+	if( params.count( "max_epochs" ) )
+		sscanf( params[ "max_epochs" ].c_str() , "%d" , &maxEpochs ) ;
+
+	if( params.count( "num_swaps" ) )
+		sscanf( params[ "num_swaps" ].c_str() , "%d" , &numMigrationSwaps ) ;
+}
+
+void structureoptimizer::IslandSearch::printParameters(){
+	printf( "Island algorithm: '%s'\n" , algorithm.c_str() ) ;
+	printf( "Island parameters file: '%s'\n" , algorithmParametersFile.c_str() ) ;
+	printf( "Number of islands: %d\n" , islandCount ) ;
+	printf( "Islands at the same time: %s\n" , concurrent ? "true" : "false" ) ;
+	printf( "Max number of epochs: %d\n" , maxEpochs ) ;
+	printf( "Num. of migration swaps: %d\n" , numMigrationSwaps ) ;
+	islands[ 0 ]->printParameters() ;
+}
+
+void structureoptimizer::IslandSearch::initialize(){
+	printf( " ======== Island Search ======== \n" ) ;
+	for(int i = 0 ; i < islandCount ; i++){
+		PermutationSet* set = initializer->generate() ;
+		startOrders[ i ] = set->getPermutation() ;
+		delete set ;
+		bestOrders[ i ].clear() ;
+
+		// the islands draw from the streams of this search
+		islands[ i ]->setSeed( gen() , i ) ;
+		islandGens[ i ].seed( gen() ) ;
+
+		for(int j = 0 ; j < published[ i ].size() ; j++) delete published[ i ][ j ] ;
+		published[ i ].clear() ;
+		mailbox[ i ] = NULL ;
+	}
+}
+
+datastructures::BNStructure structureoptimizer::IslandSearch::search_internal(){
+	if( concurrent ){
+		std::vector<boost::thread*> threads ;
+		for(int island = 1 ; island < islandCount ; island++)
+			threads.push_back( new boost::thread( &structureoptimizer::IslandSearch::work , this , island ) ) ;
+		work( 0 ) ;
+		for(int i = 0 ; i < threads.size() ; i++){
+			threads[ i ]->join() ;
+			delete threads[ i ] ;
+		}
+	}else{
+		// one island after another, they still see each other's orders
+		for(int epoch = 0 ; epoch < maxEpochs ; epoch++){
+			bool running = false ;
+			for(int island = 0 ; island < islandCount ; island++)
+				running = runEpoch( island , epoch ) || running ;
+			if( !running ) break ;
+		}
+	}
+
+	// ties go to the island with the lowest index
+	int bestIsland = 0 ;
+	for(int i = 1 ; i < islandCount ; i++)
+		if( compare( bestScores[ i ] , bestScores[ bestIsland ] ) < 0 ) bestIsland = i ;
+
+	PermutationSet* set = structureoptimizer::createSet( GREEDY_BEHAVIOR_SET , variableCount , bestScoreCalculators ) ;
+	set->setPermutation( bestOrders[ bestIsland ] ) ;
+	datastructures::BNStructure best( set , bestScoreCalculators ) ;
+	delete set ;
+	printf( " === Best island = %d ===\n" , bestIsland ) ;
+	printf( "Score = %.6f\n" , best.getScore() ) ;
+	t->cancel() ;
+	return best ;
+}
+
+void structureoptimizer::IslandSearch::work( int island ){
+	for(int epoch = 0 ; epoch < maxEpochs ; epoch++)
+		if( !runEpoch( island , epoch ) ) break ;
+}
+
+bool structureoptimizer::IslandSearch::runEpoch( int island , int epoch ){
+	// every island runs at least one search
+	long timeLimit = 0 ;
+	if( !deadline.is_pos_infinity() ){
+		timeLimit = ( deadline - boost::posix_time::microsec_clock::universal_time() ).total_milliseconds() ;
+		if( epoch > 0 && timeLimit <= 0 ) return false ;
+		timeLimit = std::max( timeLimit , 1L ) ;
+	}
+	if( epoch > 0 && outOfTime ) return false ;
+
+	islandInitializers[ island ]->setOrder( startOrders[ island ] ) ;
+	datastructures::BNStructure result = islands[ island ]->searchOnce( timeLimit ) ;
+
+	// any order of the structure scores at least as well as the structure
+	PermutationSet* set = structureoptimizer::createSet( GREEDY_BEHAVIOR_SET , variableCount , bestScoreCalculators ) ;
+	set->setPermutation( result.getOrder() ) ;
+	if( bestOrders[ island ].empty() || compare( set->getScore() , bestScores[ island ] ) < 0 ){
+		bestOrders[ island ] = set->getPermutation() ;
+		bestScores[ island ] = set->getScore() ;
+
+		Migrant* migrant = new Migrant() ;
+		migrant->order = bestOrders[ island ] ;
+		migrant->score = bestScores[ island ] ;
+		published[ island ].push_back( migrant ) ;
+		mailbox[ island ].store( migrant , boost::memory_order_release ) ;
+	}
+	delete set ;
+
+	// continue from the best order known, moved away from its local optimum
+	const Migrant* migrant = bestMigrant( island ) ;
+	std::vector<int> order = migrant != NULL ? migrant->order : bestOrders[ island ] ;
+	for(int i = 0 ; i < numMigrationSwaps ; i++){
+		int idx1 = random_generator( variableCount , islandGens[ island ] ) ;
+		int idx2 = random_generator( variableCount , islandGens[ island ] ) ;
+		std::swap( order[ idx1 ] , order[ idx2 ] ) ;
+	}
+	startOrders[ island ] = order ;
+
+	printf( " === Island %d, epoch %d: score = %.6f%s ===\n" , island , epoch ,
+				bestScores[ island ] , migrant != NULL ? ", migrating" : "" ) ;
+	return true ;
+}
+
+const structureoptimizer::IslandSearch::Migrant* structureoptimizer::IslandSearch::bestMigrant( int island ){
+	// an order from another island, only if it is better than the own one
+	const Migrant* best = NULL ;
+	float bestScore = bestScores[ island ] ;
+	for(int i = 0 ; i < islandCount ; i++){
+		if( i == island ) continue ;
+		const Migrant* migrant = mailbox[ i ].load( boost::memory_order_acquire ) ;
+		if( migrant == NULL || compare( migrant->score , bestScore ) >= 0 ) continue ;
+		best = migrant ;
+		bestScore = migrant->score ;
+	}
+	return best ;
+}
@@ -0,0 +1,82 @@
+/*
+ * File:   island_search.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef ISLAND_SEARCH_H
+#define	ISLAND_SEARCH_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/random.hpp>
+
+#include "structure_optimizer.h"
+#include "order_initializer.h"
+#include "bn_structure.h"
+
+namespace structureoptimizer {
+	/**
+	 * Island model over another order-based search.
+	 *
+	 * Every island runs its own copy of the algorithm, with its usual
+	 * parameters file, in its own thread.  After each search (an epoch) the
+	 * island publishes its best order when it improves, and starts the next
+	 * search from the best order published by any island, perturbed by a few
+	 * random swaps.  The mailbox only holds pointers to orders which are never
+	 * changed, so no island waits for another one.
+	 */
+	class IslandSearch : public StructureOptimizer {
+		public :
+			IslandSearch() ;
+			IslandSearch( initializers::Initializer* initializer ,
+						std::vector<bestscorecalculators::BestScoreCalculator*> bestScoreCalculator ,
+						std::string parametersFile ) ;
+			~IslandSearch() ;
+
+			void printParameters() ;
+
+		private :
+			struct Migrant {
+				std::vector<int> order ;
+				float score ;
+			} ;
+
+			void initialize() ;
+			datastructures::BNStructure search_internal() ;
+			void work( int island ) ;
+			bool runEpoch( int island , int epoch ) ;
+			const Migrant* bestMigrant( int island ) ;
+
+			void setDefaultParameters() ;
+			void setFileParameters( std::map<std::string,std::string> params ) ;
+
+			std::vector<StructureOptimizer*> islands ;
+			std::vector<initializers::OrderInitializer*> islandInitializers ;
+			std::vector<boost::mt19937> islandGens ;
+			bool concurrent ;
+
+			// for each island, the order of its next search and the best one found
+			std::vector< std::vector<int> > startOrders ;
+			std::vector< std::vector<int> > bestOrders ;
+			std::vector<float> bestScores ;
+
+			// the last order published by each island; every order published
+			// is kept until the search ends, as others may still read it
+			boost::atomic<Migrant*>* mailbox ;
+			std::vector< std::vector<Migrant*> > published ;
+
+			// Configurable parameters
+			std::string algorithm ;
+			std::string algorithmParametersFile ;
+			int islandCount ;
+			int maxEpochs ;
+			int numMigrationSwaps ;
+	} ;
+}
+
+#endif	/* ISLAND_SEARCH_H */
@@ -83,6 +83,10 @@ int main( int argc , char** argv ){
 		( bnetFileShortCut.c_str() , po::value<std::string> (&bnetFile), bnetFileString.c_str() )
 		( delimiterShortCut.c_str() , po::value<char> (&delimiter)->required()->default_value( delimiterDefault ), delimiterString.c_str() )
 		( rMinShortCut.c_str() , po::value<int> (&rMin)->default_value( rMinDefault ), rMinString.c_str() )
+		( adTreeTypeShortCut.c_str() , po::value<std::string>(&adTreeType)->default_value( adTreeTypeDefault ) , scoring::adTreeTypeString.c_str() )
+		( counterTypeShortCut.c_str() , po::value<std::string>(&counterType)->default_value( counterTypeDefault ) , scoring::counterTypeString.c_str() )
+		( partitionCacheSizeShortCut.c_str() , po::value<int> (&partitionCacheSize)->default_value( partitionCacheSizeDefault ) , partitionCacheSizeString.c_str() )
+		( frontierMemoryShortCut.c_str() , po::value<int> (&frontierMemory)->default_value( frontierMemoryDefault ) , frontierMemoryString.c_str() )
 		( maxParentsShortCut.c_str() , po::value<int> (&maxParents)->default_value( maxParentsDefault ) , maxParentsString.c_str() )
 		( threadCountShortCut.c_str() , po::value<int> (&threadCount)->default_value( threadCountDefault ) , threadString.c_str() )
 		( runningTimeShortCut.c_str() , po::value<int> (&runningTime)->default_value( runningTimeDefault ) , runningTimeString.c_str() )
@@ -91,12 +95,15 @@ int main( int argc , char** argv ){
 		( whileCalculatingPruningShortCut.c_str() , whileCalculatingPruningString.c_str() )
 		( selectionTypeShortCut.c_str() , po::value<std::string>(&selectionType)->default_value( selectionTypeDefault ) , parentselection::parentSetSelectionString.c_str() )
 		( sfShortCut.c_str() , po::value<std::string>( &sf )->default_value( sfDefault ) , sfString.c_str() )
+		( scoresFileFormatShortCut.c_str() , po::value<std::string>( &scoresFileFormat )->default_value( scoresFileFormatDefault ) , scoresFileFormatString.c_str() )
 		( constraintsFileShortCut.c_str() , po::value<std::string>( &constraintsFile ) , constraintsFileString.c_str() )
 		( structureOptimizerTypeShortCut.c_str() , po::value<std::string>(&structureOptimizerType)->required()->default_value( structureOptimizerTypeDefault) , structureOptimizerTypeString.c_str() )
 		( bestScoreCalculatorShortCut.c_str() , po::value<std::string > (&bestScoreCalculator)->default_value( bestScoreCalculatorDefault ) , bestscorecalculators::bestScoreCalculatorString.c_str() )
 		( initializerShortCut.c_str() , po::value<std::string > (&initializerType)->default_value( initializerTypeDefault ) , initializers::initializerTypeString.c_str() )
 		( numSolutionsShortCut.c_str() , po::value<int> (&numSolutions)->default_value( numSolutionsDefault ) , numSolutionsString.c_str() )
 		( timePerSolutionsShortCut.c_str() , po::value<int> ( &timePerSolution)->default_value( timePerSolutionDefault ) , timePerSolutionString.c_str() )
+		( totalTimeShortCut.c_str() , po::value<int> ( &totalTime )->default_value( totalTimeDefault ) , totalTimeString.c_str() )
+		( restartThreadsShortCut.c_str() , po::value<int> ( &restartThreads )->default_value( restartThreadsDefault ) , restartThreadsString.c_str() )
 		( structureParametersFileShortCut.c_str() , po::value<std::string>(&structureParametersFile) , structureParametersFileString.c_str() )
 		( "help,h" , "Show this help message." ) ;
 
@@ -124,6 +131,10 @@ int main( int argc , char** argv ){
 		threadCount = 1 ;
 	}
 
+	if( restartThreads < 1 ){
+		restartThreads = 1 ;
+	}
+
 	printf( " ============================== BN_LEARNING ============================== \n" ) ;
 	printf( "Dataset file: '%s'\n" , datasetFile.size() == 0 ? "NO SPECIFIED" : datasetFile.c_str() ) ;
 	printf( "Score file: '%s'\n" , scoresFile.c_str() ) ;
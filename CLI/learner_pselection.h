@@ -20,11 +20,13 @@
 #include "record_file.h"
 #include "bayesian_network.h"
 #include "ad_tree.h"
+#include "ad_tree_creator.h"
 #include "score_cache.h"
 #include "scoring_function.h"
 #include "scoring_function_creator.h"
 #include "parent_set_selection.h"
 #include "parent_set_selection_creator.h"
+#include "scoring_scheduler.h"
 #include "node.h"
 #include "utils.h"
 #include "files.h"
@@ -43,6 +45,28 @@ int rMin = rMinDefault ;
 std::string rMinString = "The minimum number of records in the AD-tree nodes." ;
 std::string rMinShortCut = "rMin,m" ;
 
+/* The AD-tree implementation */
+std::string adTreeTypeDefault = "pointer" ;
+std::string adTreeType = adTreeTypeDefault ;
+std::string adTreeTypeShortCut = "adTree,a" ;
+
+/* The counting engine */
+std::string counterTypeDefault = "adtree" ;
+std::string counterType = counterTypeDefault ;
+std::string counterTypeShortCut = "counter" ;
+
+/* The memory for cached record partitions, in MB */
+int partitionCacheSizeDefault = 0 ;
+int partitionCacheSize = partitionCacheSizeDefault ;
+std::string partitionCacheSizeString = "The memory (MB) for caching the partitions of the records by parent set. Tables too big to count directly are then refined from the partition of a subset instead of being built by the counter. 0 disables the cache." ;
+std::string partitionCacheSizeShortCut = "partitionCache" ;
+
+/* The memory for the frontier of the breadth-first search */
+int frontierMemoryDefault = 0 ;
+int frontierMemory = frontierMemoryDefault ;
+std::string frontierMemoryString = "The memory (MB) for the layers of the sequential parent set search. What does not fit is sorted and written next to the score file. 0 means no limit." ;
+std::string frontierMemoryShortCut = "frontierMemory" ;
+
 /* A hard limit on the size of parent sets */
 int maxParentsDefault = 0 ;
 int maxParents = maxParentsDefault ;
@@ -86,6 +110,12 @@ std::string constraintsFile ;
 std::string constraintsFileString = "Constraints for parent's variables" ;
 std::string constraintsFileShortCut = "constraintsfile" ;
 
+/* The format of the score file */
+std::string scoresFileFormatDefault = "text" ;
+std::string scoresFileFormat = scoresFileFormatDefault ;
+std::string scoresFileFormatString = "The format of the score file. Options: 'text' (pss), 'binary'. Both are read back automatically." ;
+std::string scoresFileFormatShortCut = "scoreFormat" ;
+
 /* The scoring function to use */
 std::string sfDefault = "BIC" ;
 std::string sf = sfDefault ;
@@ -101,23 +131,26 @@ datastructures::BayesianNetwork network ;
 /* The constraints information */
 scoring::Constraints *constraints ;
 
+/* Hands out the variables to the scoring threads */
+parentselection::ScoringScheduler *scheduler ;
+
 void scoringThread( int thread ){
 	parentselection::ParentSetSelection* pss = 
 			parentselection::create( selectionType , scoringFunction ,
 									maxParents , network.size() ,
 									runningTime , constraints ) ;
-	for( int variable = 0 ; variable < network.size() ; variable++ ){
-		if( variable % threadCount != thread ){
-			continue ;
-		}
+	pss->setScheduler( scheduler ) ;
 
+	// the map keeps its memory when cleared, so reuse it for every variable
+	FloatMap sc ;
+	init_map( sc ) ;
+	for( int variable = scheduler->nextVariable() ; variable >= 0 ; variable = scheduler->nextVariable() ){
 		std::string varFilename = scoresFile + "." + TO_STRING( variable ) ;
 		if( file_exists( varFilename ) ) continue ;
 
 		printf( "Thread: %d , Variable: %d , Time: %s\n" , thread , variable , getTime().c_str() ) ;
 
-		FloatMap sc ;
-		init_map( sc ) ;
+		pss->setFrontier( (size_t) frontierMemory * 1024 * 1024 , varFilename + ".frontier" ) ;
 		pss->calculateScores( variable , sc ) ;
 
 		int size = sc.size() ;
@@ -129,10 +162,13 @@ void scoringThread( int thread ){
 			printf( "Thread: %d , Variable: %d , Size after pruning: %d , Time: %s\n" , thread , variable , prunedSize , getTime().c_str() ) ;
 		}
 
-		createVariableScoreFile( varFilename , network , variable , sc ) ;
+		createVariableScoreFile( varFilename , network , variable , sc , scoresFileFormat ) ;
 
 		sc.clear() ;
 	}
+
+	// out of variables, so help the threads which are still scoring
+	scheduler->help() ;
 }
 
 void calculateScore(){
@@ -140,7 +176,12 @@ void calculateScore(){
 	printf( "Method: %s\n" , selectionType.c_str() ) ;
 	printf( "Delimiter: '%c'\n" , delimiter ) ;
 	printf( "r_min: '%d'\n" , rMin ) ;
+	printf( "Counter: '%s'\n" , counterType.c_str() ) ;
+	printf( "AD-tree: '%s'\n" , adTreeType.c_str() ) ;
+	printf( "Partition cache (MB): '%d'\n" , partitionCacheSize ) ;
+	printf( "Frontier memory (MB): '%d'\n" , frontierMemory ) ;
 	printf( "Scoring function: '%s'\n" , sf.c_str() ) ;
+	printf( "Score file format: '%s'\n" , scoresFileFormat.c_str() ) ;
 	printf( "Maximum parents: '%d'\n" , maxParents ) ;
 	printf( "Threads: '%d'\n" , threadCount ) ;
 	printf( "Running time (per variable): '%d'\n" , runningTime ) ;
@@ -148,15 +189,19 @@ void calculateScore(){
 	printf( "Enable while-calculating pruning: '%s'\n" , ( whileCalculatingPruning ? "true" : "false" ) ) ;
 	printf( "Enable end-of-calculating pruning: '%s'\n" , ( endOfCalculatingPruning ? "true" : "false" ) ) ;
 
+	if( scoresFileFormat != "text" && scoresFileFormat != "binary" ){
+		throw std::runtime_error( "Invalid score file format: '" + scoresFileFormat + "'. Valid options are 'text' and 'binary'." ) ;
+	}
+
 	printf( "Parsing input file.\n" ) ;
 	datastructures::RecordFile recordFile( datasetFile , delimiter , hasHeader ) ;
-	recordFile.read() ;
+	recordFile.read( threadCount ) ;
 
 	printf( "Initializing data specifications.\n" ) ;
 	network.initialize( recordFile ) ;
 
 	printf( "Creating AD-tree.\n" ) ;
-	scoring::ADTree *adTree = new scoring::ADTree( rMin ) ;
+	scoring::ADTree *adTree = scoring::createCounter( counterType , adTreeType , rMin ) ;
 	adTree->initialize( network , recordFile ) ;
 	adTree->createTree() ;
 
@@ -165,17 +210,27 @@ void calculateScore(){
 		constraints = scoring::parseConstraints( constraintsFile , network ) ;
 
 	printf( "Creating the score function calculator\n" ) ;
-	scoringFunction = scoring::create( sf , adTree , network , recordFile , constraints , whileCalculatingPruning ) ;
+	scoringFunction = scoring::create( sf , adTree , network , recordFile , constraints , whileCalculatingPruning , partitionCacheSize ) ;
 	maxParents = scoring::parentsize( sf, maxParents , network , recordFile ) ;
 	
+	// the parallel search scores one variable at a time and the other
+	// threads only help with its layers
+	int variableThreads = selectionType == "parallel_sequential" ? 1 : threadCount ;
+	scheduler = new parentselection::ScoringScheduler( network.size() , variableThreads ) ;
 	std::vector<boost::thread*> threads ;
 	for( int thread = 0 ; thread < threadCount ; thread++){
-		boost::thread *workerThread = new boost::thread( scoringThread , thread ) ;
+		boost::thread *workerThread ;
+		if( thread < variableThreads ){
+			workerThread = new boost::thread( scoringThread , thread ) ;
+		}else{
+			workerThread = new boost::thread( &parentselection::ScoringScheduler::help , scheduler ) ;
+		}
 		threads.push_back( workerThread ) ;
 	}
 
 	for( auto it = threads.begin() ; it != threads.end() ; it++)
 		( *it )->join() ;
+	delete scheduler ;
 
 	// concatenate all of the files together
 	std::map<std::string,std::string> metadata ;
@@ -185,7 +240,7 @@ void calculateScore(){
 	metadata[ "maxParents" ] = TO_STRING( maxParents ) ;
 	metadata[ "scoringFunction" ] = sf ;
 	metadata[ "parentSelection" ] = selectionType ;
-	concatenateScoreFiles( scoresFile , metadata ) ;
+	concatenateScoreFiles( scoresFile , metadata , scoresFileFormat ) ;
 }
 
 #endif	/* PSELECTION_H */
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "score_cache.h"
 #include "structure_optimizer.h"
 #include "structure_optimizer_creator.h"
+#include "multi_start_search.h"
 #include "initializer.h"
 #include "initializer_creator.h"
 #include "best_score_calculator.h"
@@ -46,6 +47,18 @@ int timePerSolution = timePerSolutionDefault ; // Unlimited
 std::string timePerSolutionString = "Maximum time for processing each initial solution" ;
 std::string timePerSolutionsShortCut = "timePerSolution,e" ;
 
+/* Maximum time to obtain results for all of the initial solutions */
+int totalTimeDefault = 0 ; // Unlimited
+int totalTime = totalTimeDefault ;
+std::string totalTimeString = "Maximum time for processing all of the initial solutions" ;
+std::string totalTimeShortCut = "totalTime" ;
+
+/* Number of initial solutions processed at the same time */
+int restartThreadsDefault = 1 ;
+int restartThreads = restartThreadsDefault ;
+std::string restartThreadsString = "Number of initial solutions processed at the same time, each by its own thread." ;
+std::string restartThreadsShortCut = "restartThreads" ;
+
 /* Parameters file for structure learning algorithm */
 std::string structureParametersFile ;
 std::string structureParametersFileString = "Parameters file for structure learning algorithm" ;
@@ -94,6 +107,7 @@ void structureLearning(){
 	printf( "Initialization type: '%s'\n" , initializerType.c_str() ) ;
 	printf( "Learning algorithm: '%s'\n" , structureOptimizerType.c_str() ) ;
 	printf( "Max. time per solution (sec): %d\n" , timePerSolution ) ;
+	printf( "Max. total time (sec): %d\n" , totalTime ) ;
 
 	printf( "Reading score cache.\n" ) ;
 	cache.read( scoresFile ) ;
@@ -103,13 +117,33 @@ void structureLearning(){
 	printf( "Creating Best score calculators.\n" ) ;
 	std::vector<bestscorecalculators::BestScoreCalculator*> bestScCalc = bestscorecalculators::create( bestScoreCalculator , cache ) ;
 
-	printf( "Creating Initialization heuristic.\n" ) ;
-	initializers::Initializer* initializer = initializers::create( initializerType , bestScCalc ) ;
+	// concurrent searches share the calculators, so they must allow it
+	for(int i = 0 ; i < bestScCalc.size() ; i++){
+		if( restartThreads > 1 && !bestScCalc[ i ]->isConcurrent() ){
+			printf( "Best score calculator '%s' can not be shared, restarts run one at a time.\n" , bestScoreCalculator.c_str() ) ;
+			restartThreads = 1 ;
+		}
+	}
+	printf( "Restart threads: %d\n" , restartThreads ) ;
 
-	printf( "Creating the order-based structure learning algorithm\n" ) ;
-	structureoptimizer::StructureOptimizer* algorithm = structureoptimizer::create( structureOptimizerType , initializer , bestScCalc , structureParametersFile ) ;
-	algorithm->printParameters() ;
-	datastructures::BNStructure solution = algorithm->search( numSolutions , timePerSolution ) ;
+	// one algorithm with its own initializer for each thread
+	std::vector<structureoptimizer::StructureOptimizer*> algorithms ;
+	for(int thread = 0 ; thread < restartThreads ; thread++){
+		printf( "Creating Initialization heuristic.\n" ) ;
+		initializers::Initializer* initializer = initializers::create( initializerType , bestScCalc ) ;
+
+		printf( "Creating the order-based structure learning algorithm\n" ) ;
+		algorithms.push_back( structureoptimizer::create( structureOptimizerType , initializer , bestScCalc , structureParametersFile ) ) ;
+	}
+	algorithms[ 0 ]->printParameters() ;
+
+	datastructures::BNStructure solution ;
+	if( restartThreads == 1 ){
+		solution = algorithms[ 0 ]->search( numSolutions , timePerSolution , totalTime ) ;
+	}else{
+		structureoptimizer::MultiStartSearch search( algorithms , time( NULL ) ) ;
+		solution = search.search( numSolutions , timePerSolution , totalTime ) ;
+	}
 	printSolution( bnetFile , solution ) ;
 }
 
@@ -1,17 +1,22 @@
+#include <algorithm>
+
 #include "log_likelihood_calculator.h"
 
+const uint64_t scoring::LogLikelihoodCalculator::MAX_DENSE_CELLS ;
+
 scoring::LogLikelihoodCalculator::LogLikelihoodCalculator() {
-	// Do nothing
+	partitionCache = NULL ;
 }
 
 scoring::LogLikelihoodCalculator::LogLikelihoodCalculator( scoring::ADTree *adTree ,
 														datastructures::BayesianNetwork &network ,
 														std::vector<float> &ilogi ){
+	partitionCache = NULL ;
 	initialize( adTree , network , ilogi ) ;
 }
 
 scoring::LogLikelihoodCalculator::~LogLikelihoodCalculator(){
-	// Do nothing
+	delete partitionCache ;
 }
 
 void scoring::LogLikelihoodCalculator::initialize( ADTree *adTree ,
@@ -21,9 +26,41 @@ void scoring::LogLikelihoodCalculator::initialize( ADTree *adTree ,
 	this->network = network ;
 	this->ilogi = ilogi ;
 	this->recordFileSize = ilogi.size() - 2 ;
+	this->recordCount = 0 ;
+}
+
+/**
+ * Keep the data set so that small tables can be counted directly instead of
+ * through the AD-tree.
+ */
+void scoring::LogLikelihoodCalculator::setRecords( datastructures::RecordFile &recordFile ){
+	this->columns = network.getValueColumns( recordFile ) ;
+	this->recordCount = recordFile.size() ;
+}
+
+/**
+ * Keep up to {@code maxBytes} of record partitions, so that the tables too
+ * big to count densely are built by refining the partition of a subset of
+ * the parents instead of through the AD-tree.  Zero disables the cache.
+ */
+void scoring::LogLikelihoodCalculator::setPartitionCacheSize( size_t maxBytes ){
+	delete partitionCache ;
+	partitionCache = ( maxBytes > 0 ? new PartitionCache( maxBytes ) : NULL ) ;
 }
 
 float scoring::LogLikelihoodCalculator::calculate( int variable , varset& parents ){
+	uint64_t cells ;
+	if( useDenseCounts( variable , parents , cells ) ){
+		VARSET_SET( parents , variable ) ;
+		float score = calculateDense( parents , variable , cells ) ;
+		VARSET_CLEAR( parents , variable ) ;
+		return score ;
+	}
+
+	if( partitionCache != NULL && columns.size() > 0 ){
+		return calculatePartition( variable , parents ) ;
+	}
+
 	boost::unordered_map<uint64_t,int> paCounts ;
 	return calculate( variable , parents , paCounts ) ;
 }
@@ -48,6 +85,195 @@ float scoring::LogLikelihoodCalculator::calculate( int variable , varset& parent
 	return score ;
 }
 
+scoring::LogLikelihoodCalculator::DenseScratch &scoring::LogLikelihoodCalculator::getDenseScratch(){
+	if( denseScratch.get() == NULL ){
+		denseScratch.reset( new DenseScratch() ) ;
+	}
+	return *denseScratch ;
+}
+
+/**
+ * Check whether the table of variable and parents is small enough to count
+ * into a dense array.  It has to fit in MAX_DENSE_CELLS and have no more
+ * cells than there are records; bigger tables are mostly empty and are
+ * cheaper to build from the AD-tree.
+ */
+bool scoring::LogLikelihoodCalculator::useDenseCounts( int variable , varset &parents , uint64_t &cells ){
+	if( columns.size() == 0 ) return false ;
+
+	uint64_t limit = std::min( MAX_DENSE_CELLS , ( uint64_t ) recordCount ) ;
+	cells = network.getCardinality( variable ) ;
+	for( int x = 0 ; x < network.size() && cells <= limit ; x++){
+		if( VARSET_GET( parents , x ) ){
+			cells *= network.getCardinality( x ) ;
+		}
+	}
+	return cells <= limit ;
+}
+
+/**
+ * Count the records of the data set straight into a dense table indexed in
+ * mixed radix over the sorted variables (including the child variable), the
+ * lowest variable index being the most significant digit.  The cells are
+ * then summed in the same order as the leaves of the contingency table.
+ */
+float scoring::LogLikelihoodCalculator::calculateDense( varset &variables , int variable , uint64_t cells ){
+	DenseScratch &scratch = getDenseScratch() ;
+
+	// the index of the cell of every record
+	std::vector<uint32_t> &index = scratch.index ;
+	index.assign( recordCount , 0 ) ;
+	uint64_t lowSize = 1 ;
+	for( int x = 0 ; x < network.size() ; x++){
+		if( !VARSET_GET( variables , x ) ) continue ;
+
+		uint32_t card = network.getCardinality( x ) ;
+		const uint16_t *column = &columns[ x ][ 0 ] ;
+		uint32_t *idx = &index[ 0 ] ;
+		for( int r = 0 ; r < recordCount ; r++){
+			idx[ r ] = idx[ r ] * card + column[ r ] ;
+		}
+
+		if( x > variable ) lowSize *= card ;
+	}
+
+	std::vector<int> &counts = scratch.counts ;
+	counts.assign( cells , 0 ) ;
+	for( int r = 0 ; r < recordCount ; r++){
+		counts[ index[ r ] ]++ ;
+	}
+
+	// accumulate in double; the two sums are large and mostly cancel
+	double score = 0 ;
+	for( uint64_t c = 0 ; c < cells ; c++){
+		score += ilogi[ counts[ c ] ] ;
+	}
+
+	// marginalize the child variable out to get the parent counts
+	int card = network.getCardinality( variable ) ;
+	uint64_t highSize = cells / ( card * lowSize ) ;
+	std::vector<int> &paCounts = scratch.paCounts ;
+	paCounts.assign( highSize * lowSize , 0 ) ;
+	for( uint64_t high = 0 ; high < highSize ; high++){
+		int *pa = &paCounts[ high * lowSize ] ;
+		for( int k = 0 ; k < card ; k++){
+			const int *count = &counts[ ( high * card + k ) * lowSize ] ;
+			for( uint64_t low = 0 ; low < lowSize ; low++){
+				pa[ low ] += count[ low ] ;
+			}
+		}
+	}
+
+	for( uint64_t p = 0 ; p < paCounts.size() ; p++){
+		score -= ilogi[ paCounts[ p ] ] ;
+	}
+
+	return score ;
+}
+
+/**
+ * Get the partition of the records by {@code parents}.  It comes from the
+ * cache, or by refining the cached partition of {@code parents} minus one
+ * variable, or, failing both, by refining all of the records one parent at
+ * a time.
+ */
+scoring::PartitionPtr scoring::LogLikelihoodCalculator::getPartition( varset &parents ){
+	PartitionPtr partition = partitionCache->get( parents ) ;
+	if( partition ) return partition ;
+
+	for( int x = 0 ; x < network.size() && !partition ; x++){
+		if( !VARSET_GET( parents , x ) ) continue ;
+
+		VARSET_CLEAR( parents , x ) ;
+		PartitionPtr subset = partitionCache->get( parents ) ;
+		VARSET_SET( parents , x ) ;
+
+		if( subset ){
+			partition = subset->refine( columns[ x ] , network.getCardinality( x ) ) ;
+		}
+	}
+
+	if( !partition ){
+		PartitionPtr refined = Partition::all( recordCount ) ;
+		for( int x = 0 ; x < network.size() ; x++){
+			if( VARSET_GET( parents , x ) ){
+				refined = refined->refine( columns[ x ] , network.getCardinality( x ) ) ;
+			}
+		}
+		partition = refined ;
+	}
+
+	partitionCache->put( parents , partition ) ;
+	return partition ;
+}
+
+// Orders the groups of a partition by the parent values of their records
+struct GroupConfigurationLess {
+	GroupConfigurationLess( const scoring::Partition &partition ,
+							const std::vector< std::vector<uint16_t> > &columns ,
+							const std::vector<int> &parents ) :
+		partition( partition ) , columns( columns ) , parents( parents ) {}
+
+	bool operator()( int a , int b ) const {
+		uint32_t ra = partition.records[ partition.starts[ a ] ] ;
+		uint32_t rb = partition.records[ partition.starts[ b ] ] ;
+		for( int i = 0 ; i < parents.size() ; i++){
+			const std::vector<uint16_t> &column = columns[ parents[ i ] ] ;
+			if( column[ ra ] != column[ rb ] ) return column[ ra ] < column[ rb ] ;
+		}
+		return false ;
+	}
+
+	const scoring::Partition &partition ;
+	const std::vector< std::vector<uint16_t> > &columns ;
+	const std::vector<int> &parents ;
+} ;
+
+/**
+ * Count the values of {@code variable} within each group of the partition
+ * of the records by {@code parents}.  The order of the groups depends on the
+ * subset the partition was refined from, so they are summed by parent
+ * configuration, the lowest variable being the most significant, and the
+ * score does not depend on what the other threads left in the cache.
+ */
+float scoring::LogLikelihoodCalculator::calculatePartition( int variable , varset &parents ){
+	PartitionPtr partition = getPartition( parents ) ;
+
+	DenseScratch &scratch = getDenseScratch() ;
+	std::vector<int> parentList ;
+	for( int x = 0 ; x < network.size() ; x++){
+		if( VARSET_GET( parents , x ) ) parentList.push_back( x ) ;
+	}
+	std::vector<int> &groupOrder = scratch.groupOrder ;
+	groupOrder.resize( partition->groupCount() ) ;
+	for( int g = 0 ; g < groupOrder.size() ; g++) groupOrder[ g ] = g ;
+	std::sort( groupOrder.begin() , groupOrder.end() , GroupConfigurationLess( *partition , columns , parentList ) ) ;
+
+	int card = network.getCardinality( variable ) ;
+	std::vector<int> &counts = scratch.valueCounts ;
+	counts.assign( card , 0 ) ;
+
+	const uint16_t *column = &columns[ variable ][ 0 ] ;
+	const uint32_t *records = &partition->records[ 0 ] ;
+	double score = 0 ;
+	for( int i = 0 ; i < groupOrder.size() ; i++){
+		int g = groupOrder[ i ] ;
+		uint32_t start = partition->starts[ g ] ;
+		uint32_t end = partition->starts[ g + 1 ] ;
+		for( uint32_t r = start ; r < end ; r++){
+			counts[ column[ records[ r ] ] ]++ ;
+		}
+
+		for( int k = 0 ; k < card ; k++){
+			score += ilogi[ counts[ k ] ] ;
+			counts[ k ] = 0 ;
+		}
+		score -= ilogi[ end - start ] ;
+	}
+
+	return score ;
+}
+
 void scoring::LogLikelihoodCalculator::calculate( ContingencyTableNode *ct ,
 												uint64_t base , uint64_t index ,
 												boost::unordered_map<uint64_t,int> &paCounts ,
@@ -8,7 +8,13 @@
 #ifndef LOG_LIKELIHOOD_CALCULATOR_H
 #define	LOG_LIKELIHOOD_CALCULATOR_H
 
+#include <stdint.h>
+#include <vector>
+
 #include "ad_tree.h"
+#include "partition_cache.h"
+#include "record_file.h"
+#include <boost/thread/tss.hpp>
 #include <boost/unordered_map.hpp>
 
 namespace scoring {
@@ -24,6 +30,8 @@ namespace scoring {
 
 			void initialize( ADTree *adTree , datastructures::BayesianNetwork &network ,
 							std::vector<float> &ilogi ) ;
+			void setRecords( datastructures::RecordFile &recordFile ) ;
+			void setPartitionCacheSize( size_t maxBytes ) ;
 			float calculate( int variable , varset &parents ) ;
 			float calculate( int variable , varset &parents ,
 							boost::unordered_map<uint64_t,int> &paCounts ) ;
@@ -40,6 +48,20 @@ namespace scoring {
 			}
 
 		private:
+			// buffers for the dense counts, one set per scoring thread
+			struct DenseScratch {
+				std::vector<uint32_t> index ;
+				std::vector<int> counts ;
+				std::vector<int> paCounts ;
+				std::vector<int> valueCounts ;
+				std::vector<int> groupOrder ;
+			} ;
+
+			DenseScratch &getDenseScratch() ;
+			bool useDenseCounts( int variable , varset &parents , uint64_t &cells ) ;
+			float calculateDense( varset &variables , int variable , uint64_t cells ) ;
+			float calculatePartition( int variable , varset &parents ) ;
+			PartitionPtr getPartition( varset &parents ) ;
 			void calculate( ContingencyTableNode *ct , uint64_t base ,
 							uint64_t index , boost::unordered_map<uint64_t,int> &paCounts ,
 							int variable , varset variables ,
@@ -49,6 +71,19 @@ namespace scoring {
 			datastructures::BayesianNetwork network ;
 			std::vector<float> ilogi ;
 			float recordFileSize ;
+
+			// the value index of every record, one column per variable; empty
+			// unless setRecords was called
+			std::vector< std::vector<uint16_t> > columns ;
+			int recordCount ;
+
+			// tables with more cells than this are never counted densely
+			static const uint64_t MAX_DENSE_CELLS = 1 << 20 ;
+
+			// partitions of the records by parent set; NULL if disabled
+			PartitionCache *partitionCache ;
+
+			boost::thread_specific_ptr<DenseScratch> denseScratch ;
 	} ;
 }
 
@@ -0,0 +1,71 @@
+/*
+ * File:   multi_start_search.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <limits>
+
+#include "multi_start_search.h"
+#include "utils.h"
+
+structureoptimizer::MultiStartSearch::MultiStartSearch( std::vector<StructureOptimizer*> optimizers , unsigned int seed ){
+	this->optimizers = optimizers ;
+	this->seed = seed ;
+}
+
+datastructures::BNStructure structureoptimizer::MultiStartSearch::search( int numSolutions , int timePerSolution , int totalTime ){
+	setbuf( stdout , NULL ) ; // In case output to file
+
+	this->numSolutions = numSolutions ;
+	this->timePerSolution = timePerSolution ;
+	this->totalTime = totalTime ;
+	this->deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds( totalTime ) ;
+	this->nextRestart = 0 ;
+	this->best = datastructures::BNStructure() ;
+	this->bestRestart = -1 ;
+	this->bestScore = std::numeric_limits<float>::max() ;
+
+	std::vector<boost::thread*> threads ;
+	for(int worker = 1 ; worker < optimizers.size() ; worker++)
+		threads.push_back( new boost::thread( &structureoptimizer::MultiStartSearch::work , this , worker ) ) ;
+	work( 0 ) ;
+	for(int i = 0 ; i < threads.size() ; i++){
+		threads[ i ]->join() ;
+		delete threads[ i ] ;
+	}
+
+	printf(" === BEST === \n" ) ;
+	printf( "Restart = %d\n" , bestRestart + 1 ) ;
+	printf( "Score = %.6f\n" , best.getScore() ) ;
+	return best ;
+}
+
+void structureoptimizer::MultiStartSearch::work( int worker ){
+	StructureOptimizer* optimizer = optimizers[ worker ] ;
+	int restart ;
+	while( ( restart = nextRestart++ ) < numSolutions ){
+		long timeLimit = timePerSolution * 1000L ;
+		if( totalTime > 0 ){
+			long remaining = ( deadline - boost::posix_time::microsec_clock::universal_time() ).total_milliseconds() ;
+			if( remaining <= 0 && restart > 0 ) return ;
+			if( timeLimit <= 0 || remaining < timeLimit ) timeLimit = std::max( remaining , 1L ) ;
+		}
+
+		optimizer->setSeed( seed , restart ) ;
+		datastructures::BNStructure current = optimizer->searchOnce( timeLimit ) ;
+
+		// most restarts do not improve, so check without the lock first
+		if( compare( current.getScore() , bestScore ) > 0 ) continue ;
+
+		boost::unique_lock<boost::mutex> lock( mutex ) ;
+		bool better = bestRestart < 0 || current.isBetter( best ) ;
+		bool tie = !better && !best.isBetter( current ) && restart < bestRestart ;
+		if( better || tie ){
+			best = current ;
+			bestRestart = restart ;
+			bestScore = current.getScore() ;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * File:   multi_start_search.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef MULTI_START_SEARCH_H
+#define	MULTI_START_SEARCH_H
+
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread.hpp>
+
+#include "bn_structure.h"
+#include "structure_optimizer.h"
+
+namespace structureoptimizer {
+
+	/**
+	 * Runs the restarts of a structure search at the same time, one per
+	 * optimizer.
+	 *
+	 * Every optimizer keeps its own search state and initializer, so each
+	 * one is only used by its own thread.  Restart k seeds its optimizer with
+	 * (seed, k), so a restart makes the same search whichever thread runs it.
+	 * The best structure found so far is shared; ties go to the restart with
+	 * the lowest index, so the result does not depend on the thread count
+	 * unless a time limit stops some of the restarts.
+	 */
+	class MultiStartSearch {
+		public :
+			MultiStartSearch( std::vector<StructureOptimizer*> optimizers , unsigned int seed ) ;
+
+			/**
+			 * Run numSolutions restarts.  Each one stops after timePerSolution
+			 * seconds, and no restart runs past totalTime seconds from now;
+			 * zero means no limit.
+			 */
+			datastructures::BNStructure search( int numSolutions , int timePerSolution , int totalTime ) ;
+
+		private :
+			void work( int worker ) ;
+
+			std::vector<StructureOptimizer*> optimizers ;
+			unsigned int seed ;
+
+			// the current search
+			int numSolutions ;
+			int timePerSolution ;
+			int totalTime ;
+			boost::posix_time::ptime deadline ;
+			boost::atomic<int> nextRestart ;
+
+			boost::mutex mutex ;
+			datastructures::BNStructure best ;
+			int bestRestart ;
+			boost::atomic<float> bestScore ;
+	} ;
+}
+
+#endif	/* MULTI_START_SEARCH_H */
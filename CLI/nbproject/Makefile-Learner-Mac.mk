@@ -42,22 +42,33 @@ OBJECTFILES= \
 	${OBJECTDIR}/beam_search.o \
 	${OBJECTDIR}/bfirst_initializer.o \
 	${OBJECTDIR}/bic_scoring_function.o \
+	${OBJECTDIR}/bitset_counter.o \
 	${OBJECTDIR}/bn_structure.o \
 	${OBJECTDIR}/dfs_initializer.o \
+	${OBJECTDIR}/external_layer.o \
 	${OBJECTDIR}/fas_initializer.o \
+	${OBJECTDIR}/flat_ad_tree.o \
 	${OBJECTDIR}/greedy_search.o \
 	${OBJECTDIR}/greedy_selection.o \
 	${OBJECTDIR}/independence_selection.o \
+	${OBJECTDIR}/island_search.o \
 	${OBJECTDIR}/learner.o \
 	${OBJECTDIR}/log_likelihood_calculator.o \
+	${OBJECTDIR}/multi_start_search.o \
+	${OBJECTDIR}/neighbourhood_evaluator.o \
+	${OBJECTDIR}/parallel_sequential_selection.o \
 	${OBJECTDIR}/parent_set_selection.o \
+	${OBJECTDIR}/partition_cache.o \
 	${OBJECTDIR}/permutation_set.o \
 	${OBJECTDIR}/random_initializer.o \
+	${OBJECTDIR}/record_file.o \
 	${OBJECTDIR}/score_cache.o \
+	${OBJECTDIR}/scoring_scheduler.o \
 	${OBJECTDIR}/sequential_selection.o \
 	${OBJECTDIR}/simulated_annealing.o \
 	${OBJECTDIR}/sparse_parent_bitwise.o \
 	${OBJECTDIR}/sparse_parent_list.o \
+	${OBJECTDIR}/sparse_parent_simd.o \
 	${OBJECTDIR}/sparse_parent_tree.o \
 	${OBJECTDIR}/structure_optimizer.o \
 	${OBJECTDIR}/swap_search.o \
@@ -124,6 +135,11 @@ ${OBJECTDIR}/bic_scoring_function.o: bic_scoring_function.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/bic_scoring_function.o bic_scoring_function.cpp
 
+${OBJECTDIR}/bitset_counter.o: bitset_counter.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/bitset_counter.o bitset_counter.cpp
+
 ${OBJECTDIR}/bn_structure.o: bn_structure.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -134,11 +150,21 @@ ${OBJECTDIR}/dfs_initializer.o: dfs_initializer.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/dfs_initializer.o dfs_initializer.cpp
 
+${OBJECTDIR}/external_layer.o: external_layer.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/external_layer.o external_layer.cpp
+
 ${OBJECTDIR}/fas_initializer.o: fas_initializer.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/fas_initializer.o fas_initializer.cpp
 
+${OBJECTDIR}/flat_ad_tree.o: flat_ad_tree.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/flat_ad_tree.o flat_ad_tree.cpp
+
 ${OBJECTDIR}/greedy_search.o: greedy_search.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -154,6 +180,11 @@ ${OBJECTDIR}/independence_selection.o: independence_selection.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/independence_selection.o independence_selection.cpp
 
+${OBJECTDIR}/island_search.o: island_search.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/island_search.o island_search.cpp
+
 ${OBJECTDIR}/learner.o: learner.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -164,11 +195,31 @@ ${OBJECTDIR}/log_likelihood_calculator.o: log_likelihood_calculator.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/log_likelihood_calculator.o log_likelihood_calculator.cpp
 
+${OBJECTDIR}/multi_start_search.o: multi_start_search.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/multi_start_search.o multi_start_search.cpp
+
+${OBJECTDIR}/neighbourhood_evaluator.o: neighbourhood_evaluator.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/neighbourhood_evaluator.o neighbourhood_evaluator.cpp
+
+${OBJECTDIR}/parallel_sequential_selection.o: parallel_sequential_selection.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/parallel_sequential_selection.o parallel_sequential_selection.cpp
+
 ${OBJECTDIR}/parent_set_selection.o: parent_set_selection.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/parent_set_selection.o parent_set_selection.cpp
 
+${OBJECTDIR}/partition_cache.o: partition_cache.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/partition_cache.o partition_cache.cpp
+
 ${OBJECTDIR}/permutation_set.o: permutation_set.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -179,11 +230,21 @@ ${OBJECTDIR}/random_initializer.o: random_initializer.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/random_initializer.o random_initializer.cpp
 
+${OBJECTDIR}/record_file.o: record_file.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/record_file.o record_file.cpp
+
 ${OBJECTDIR}/score_cache.o: score_cache.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/score_cache.o score_cache.cpp
 
+${OBJECTDIR}/scoring_scheduler.o: scoring_scheduler.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/scoring_scheduler.o scoring_scheduler.cpp
+
 ${OBJECTDIR}/sequential_selection.o: sequential_selection.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -204,6 +265,11 @@ ${OBJECTDIR}/sparse_parent_list.o: sparse_parent_list.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/sparse_parent_list.o sparse_parent_list.cpp
 
+${OBJECTDIR}/sparse_parent_simd.o: sparse_parent_simd.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O3 -s -I/usr/local/include -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/sparse_parent_simd.o sparse_parent_simd.cpp
+
 ${OBJECTDIR}/sparse_parent_tree.o: sparse_parent_tree.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
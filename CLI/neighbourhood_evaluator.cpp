@@ -0,0 +1,128 @@
+/*
+ * File:   neighbourhood_evaluator.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <typeinfo>
+
+#include "neighbourhood_evaluator.h"
+#include "utils.h"
+
+structureoptimizer::NeighbourhoodEvaluator::NeighbourhoodEvaluator(
+						std::vector<bestscorecalculators::BestScoreCalculator*> &bestScoreCalculators , int threadCount ){
+	// a calculator which changes while looking up scores can not be shared
+	for(int i = 0 ; i < bestScoreCalculators.size() ; i++)
+		if( !bestScoreCalculators[ i ]->isConcurrent() ) threadCount = 1 ;
+
+	this->threadCount = threadCount < 1 ? 1 : threadCount ;
+	this->skip = NULL ;
+	this->nextMove = 0 ;
+	this->moveCount = 0 ;
+	this->sweep = 0 ;
+	this->busyWorkers = 0 ;
+	this->stopping = false ;
+	copies.resize( this->threadCount , NULL ) ;
+	for(int thread = 1 ; thread < this->threadCount ; thread++)
+		workers.push_back( new boost::thread( &structureoptimizer::NeighbourhoodEvaluator::work , this , thread ) ) ;
+}
+
+structureoptimizer::NeighbourhoodEvaluator::~NeighbourhoodEvaluator(){
+	{
+		boost::unique_lock<boost::mutex> lock( mutex ) ;
+		stopping = true ;
+		changed.notify_all() ;
+	}
+	for(int i = 0 ; i < workers.size() ; i++){
+		workers[ i ]->join() ;
+		delete workers[ i ] ;
+	}
+	for(int thread = 1 ; thread < copies.size() ; thread++)
+		delete copies[ thread ] ;
+}
+
+int structureoptimizer::NeighbourhoodEvaluator::getThreadCount() const {
+	return threadCount ;
+}
+
+int structureoptimizer::NeighbourhoodEvaluator::findBestSwap( structureoptimizer::PermutationSet* set ){
+	return findBestSwap( set , std::vector<bool>() ) ;
+}
+
+int structureoptimizer::NeighbourhoodEvaluator::findBestSwap( structureoptimizer::PermutationSet* set ,
+																const std::vector<bool> &skip ){
+	this->skip = skip.empty() ? NULL : &skip ;
+	evaluate( set ) ;
+
+	int bestSwap = -1 ;
+	float bestScore = set->getScore() ;
+	for(int i = 0 ; i < moveCount ; i++){
+		if( this->skip != NULL && skip[ i ] ) continue ;
+		if( compare( scores[ i ] , bestScore ) >= 0 ) continue ;
+		bestScore = scores[ i ] ;
+		bestSwap = i ;
+	}
+	return bestSwap ;
+}
+
+void structureoptimizer::NeighbourhoodEvaluator::evaluate( structureoptimizer::PermutationSet* set ){
+	moveCount = set->size() - 1 ;
+	scores.resize( moveCount ) ;
+
+	if( threadCount == 1 ){
+		for(int i = 0 ; i < moveCount ; i++)
+			if( skip == NULL || !(*skip)[ i ] ) scores[ i ] = set->evaluateSwap( i ) ;
+		return ;
+	}
+
+	// the copies are updated before any thread changes the scratch state of
+	// set; a new one is only made the first time or for another kind of set
+	copies[ 0 ] = set ;
+	for(int thread = 1 ; thread < threadCount ; thread++){
+		if( copies[ thread ] != NULL && typeid( *copies[ thread ] ) == typeid( *set ) ){
+			copies[ thread ]->copyFrom( *set ) ;
+		}else{
+			delete copies[ thread ] ;
+			copies[ thread ] = set->clone() ;
+		}
+	}
+
+	{
+		boost::unique_lock<boost::mutex> lock( mutex ) ;
+		nextMove = 0 ;
+		busyWorkers = threadCount - 1 ;
+		sweep++ ;
+		changed.notify_all() ;
+	}
+	work( 0 ) ;
+
+	boost::unique_lock<boost::mutex> lock( mutex ) ;
+	while( busyWorkers > 0 )
+		changed.wait( lock ) ;
+}
+
+void structureoptimizer::NeighbourhoodEvaluator::work( int thread ){
+	int seen = 0 ;
+	while( true ){
+		if( thread > 0 ){
+			// wait for the next sweep
+			boost::unique_lock<boost::mutex> lock( mutex ) ;
+			while( !stopping && sweep == seen )
+				changed.wait( lock ) ;
+			if( stopping ) return ;
+			seen = sweep ;
+		}
+
+		PermutationSet* set = copies[ thread ] ;
+		int i ;
+		while( ( i = nextMove++ ) < moveCount )
+			if( skip == NULL || !(*skip)[ i ] ) scores[ i ] = set->evaluateSwap( i ) ;
+
+		if( thread == 0 ) return ;
+
+		boost::unique_lock<boost::mutex> lock( mutex ) ;
+		busyWorkers-- ;
+		changed.notify_all() ;
+	}
+}
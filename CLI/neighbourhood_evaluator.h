@@ -0,0 +1,71 @@
+/*
+ * File:   neighbourhood_evaluator.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef NEIGHBOURHOOD_EVALUATOR_H
+#define	NEIGHBOURHOOD_EVALUATOR_H
+
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include "best_score_calculator.h"
+#include "permutation_set.h"
+
+namespace structureoptimizer {
+
+	/**
+	 * Scores the neighbours swap( i , i + 1 ) of an order, sharing them
+	 * between a pool of threads.
+	 *
+	 * Every thread other than the caller works on its own copy of the order,
+	 * kept between sweeps and updated from the set at the start of each one,
+	 * so the scratch state of the set is never shared, and the scores are
+	 * kept by move.  The best move is then picked in order, as a single
+	 * thread would, so the result does not depend on the number of threads.
+	 * The best score calculators are shared, so the sweep only runs in
+	 * parallel if all of them support concurrent lookups.
+	 */
+	class NeighbourhoodEvaluator {
+		public :
+			NeighbourhoodEvaluator( std::vector<bestscorecalculators::BestScoreCalculator*> &bestScoreCalculators ,
+									int threadCount ) ;
+			~NeighbourhoodEvaluator() ;
+
+			/**
+			 * The index i of the best move swap( i , i + 1 ) which improves
+			 * set, or -1 if there is none.  The moves with skip[ i ] set are
+			 * not considered.  The set is left as it was.
+			 */
+			int findBestSwap( PermutationSet* set ) ;
+			int findBestSwap( PermutationSet* set , const std::vector<bool> &skip ) ;
+
+			int getThreadCount() const ;
+
+		private :
+			void evaluate( PermutationSet* set ) ;
+			void work( int thread ) ;
+
+			int threadCount ;
+			std::vector<boost::thread*> workers ;
+			std::vector<float> scores ;
+
+			// the current sweep
+			std::vector<PermutationSet*> copies ;
+			const std::vector<bool> *skip ;
+			boost::atomic<int> nextMove ;
+			int moveCount ;
+
+			boost::mutex mutex ;
+			boost::condition_variable changed ;
+			int sweep ;
+			int busyWorkers ;
+			bool stopping ;
+	} ;
+}
+
+#endif	/* NEIGHBOURHOOD_EVALUATOR_H */
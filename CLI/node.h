@@ -25,6 +25,15 @@ namespace structureoptimizer {
 				for(int i = 0 ; i < size ; i++) weights.push_back( 0. ) ;
 			}
 
+			// Back to the state of a new node, keeping the memory
+			void clear(){
+				VARSET_CLEAR_ALL( parents ) ;
+				VARSET_CLEAR_ALL( children ) ;
+				childrenVector.clear() ;
+				for(int i = 0 ; i < weights.size() ; i++) weights[ i ] = 0. ;
+				score = 0. ;
+			}
+
 			void addChild( int index , float weight = 0. ){
 				if( !VARSET_GET( children , index ) ){
 					VARSET_SET( this->children , index );
@@ -50,7 +59,7 @@ namespace structureoptimizer {
 				return children ;
 			}
 			
-			std::vector<int> getChildrenVector(){
+			const std::vector<int>& getChildrenVector() const {
 				return childrenVector ;
 			}
 
@@ -0,0 +1,45 @@
+/*
+ * File:   order_initializer.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef ORDER_INITIALIZER_H
+#define	ORDER_INITIALIZER_H
+
+#include <vector>
+
+#include "initializer.h"
+#include "permutation_set_creator.h"
+#include "best_score_calculator.h"
+
+namespace initializers {
+	// Hands out a given order, so a search can be started from it
+	class OrderInitializer : public Initializer {
+		public :
+			OrderInitializer( std::vector<bestscorecalculators::BestScoreCalculator*> bestScoreCalculators ){
+				this->variableCount = bestScoreCalculators.size() ;
+				this->bestScoreCalculators = bestScoreCalculators ;
+			}
+
+			void setOrder( std::vector<int> order ){
+				this->order = order ;
+			}
+
+			structureoptimizer::PermutationSet* generate( int setType ){
+				structureoptimizer::PermutationSet* set = structureoptimizer::createSet( setType , variableCount , bestScoreCalculators ) ;
+				set->setPermutation( order ) ;
+				return set ;
+			}
+
+			void initialize(){
+				// Do nothing
+			}
+
+		private :
+			std::vector<int> order ;
+	} ;
+}
+
+#endif	/* ORDER_INITIALIZER_H */
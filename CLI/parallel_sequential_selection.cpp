@@ -0,0 +1,175 @@
+/*
+ * File:   parallel_sequential_selection.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "utils.h"
+#include "parallel_sequential_selection.h"
+
+parentselection::ParallelSequentialSelection::ParallelSequentialSelection( scoring::ScoringFunction *scoringFunction ,
+																		int maxParents , int variableCount ,
+																		int runningTime , scoring::Constraints *constraints ){
+	this->scoringFunction = scoringFunction ;
+	this->maxParents = maxParents ;
+	this->variableCount = variableCount ;
+	this->runningTime = runningTime ;
+	this->constraints = constraints ;
+	init_map( expandedScores ) ;
+}
+
+void parentselection::ParallelSequentialSelection::calculateScores_internal( int variable , FloatMap &pruned , FloatMap& cache ){
+	while( !layer.empty() && !outOfTime ){
+		std::vector<float> scores( layer.size() , 1 ) ;
+		runLayer( layer.size() ,
+				boost::bind( &parentselection::ParallelSequentialSelection::scoreLayerItem ,
+							this , _1 , variable , &scores ) ) ;
+
+		// the supersets of a pruned set are pruned too, so only kept ones are expanded
+		expanded.clear() ;
+		expandedScores.clear() ;
+		reserve_map( cache , cache.size() + layer.size() ) ;
+		for(int l = 0 ; l < layer.size() ; l++){
+			if( compare( scores[ l ] ) >= 0 ) continue ;
+			cache[ layer[ l ] ] = scores[ l ] ;
+			float bestScore = std::max( scores[ l ] , bestSubsetScores[ l ] ) ;
+			if( scoringFunction->canImproveSupersets( variable , layer[ l ] , bestScore ) ){
+				expanded.push_back( layer[ l ] ) ;
+				expandedScores[ layer[ l ] ] = bestScore ;
+			}
+		}
+		nextLayer( variable ) ;
+	}
+	t->cancel() ;
+}
+
+void parentselection::ParallelSequentialSelection::scoreLayerItem( int index , int variable , std::vector<float> *scores ){
+	if( outOfTime ) return ;
+
+	( *scores )[ index ] = scoringFunction->calculateScore( variable , layer[ index ] ,
+															bestSubsetScores[ index ] , keptSubsets[ index ] ) ;
+}
+
+/**
+ * Build the next layer from the expanded sets, each of them generating its
+ * supersets on its own, and join them in the order of the expanded sets so
+ * the layer does not depend on how the work was shared.
+ */
+void parentselection::ParallelSequentialSelection::nextLayer( int variable ){
+	children.assign( expanded.size() , std::vector<varset>() ) ;
+	childBestSubsetScores.assign( expanded.size() , std::vector<float>() ) ;
+	childKeptSubsets.assign( expanded.size() , std::vector<int>() ) ;
+	runLayer( expanded.size() ,
+			boost::bind( &parentselection::ParallelSequentialSelection::expandItem ,
+						this , _1 , variable ) ) ;
+
+	layer.clear() ;
+	bestSubsetScores.clear() ;
+	keptSubsets.clear() ;
+	for(int i = 0 ; i < expanded.size() ; i++){
+		layer.insert( layer.end() , children[ i ].begin() , children[ i ].end() ) ;
+		bestSubsetScores.insert( bestSubsetScores.end() , childBestSubsetScores[ i ].begin() , childBestSubsetScores[ i ].end() ) ;
+		keptSubsets.insert( keptSubsets.end() , childKeptSubsets[ i ].begin() , childKeptSubsets[ i ].end() ) ;
+	}
+	children.clear() ;
+	childBestSubsetScores.clear() ;
+	childKeptSubsets.clear() ;
+}
+
+/**
+ * Generate the supersets with one more variable of the expanded set
+ * {@code index} for which it is the canonical subset.  Their bounds are the
+ * best score and the count of their immediate subsets which were expanded.
+ */
+void parentselection::ParallelSequentialSelection::expandItem( int index , int variable ){
+	if( outOfTime ) return ;
+
+	VARSET_NEW( parents , variableCount ) ;
+	parents = expanded[ index ] ;
+	if( cardinality( parents ) >= maxParents ) return ;
+
+	// only read while the layer is built, so the threads can share it
+	const FloatMap &scores = expandedScores ;
+	VARSET_NEW( superset , variableCount ) ;
+	superset = parents ;
+	for(int i = 0 ; i < options.size() ; i++){
+		int added = options[ i ] ;
+		if( added == variable || VARSET_GET( parents , added ) ) continue ;
+		VARSET_SET( superset , added ) ;
+		if( constraints->satisfiesConstraints( variable , superset ) && isCanonicalSubset( superset , added ) ){
+			float bestSubsetScore = -std::numeric_limits<float>::max() ;
+			int kept = 0 ;
+			for(int word = 0 ; 64 * word < variableCount ; word++){
+				uint64_t bits = varsetWord( superset , word ) ;
+				while( bits ){
+					int x = 64 * word + __builtin_ctzll( bits ) ;
+					bits &= bits - 1 ;
+					VARSET_CLEAR( superset , x ) ;
+					FloatMap::const_iterator it = scores.find( superset ) ;
+					if( it != scores.end() ){
+						bestSubsetScore = std::max( bestSubsetScore , it->second ) ;
+						kept++ ;
+					}
+					VARSET_SET( superset , x ) ;
+				}
+			}
+			children[ index ].push_back( superset ) ;
+			childBestSubsetScores[ index ].push_back( bestSubsetScore ) ;
+			childKeptSubsets[ index ].push_back( kept ) ;
+		}
+		VARSET_CLEAR( superset , added ) ;
+	}
+}
+
+/**
+ * Whether removing {@code added} from {@code superset} gives its canonical
+ * subset, that is, removing any higher variable leaves a set which was not
+ * expanded.  The higher variables are tried from the top, so a superset
+ * reached from another subset is usually dropped at the first lookup.  Every
+ * expanded set is kept but the empty one, which is only the subset of the
+ * first layer and generates all of it.
+ */
+bool parentselection::ParallelSequentialSelection::isCanonicalSubset( varset &superset , int added ){
+	const FloatMap &scores = expandedScores ;
+	for(int word = ( variableCount - 1 ) / 64 ; word >= added / 64 ; word--){
+		uint64_t bits = varsetWord( superset , word ) ;
+		if( word == added / 64 ) bits &= ~( ( 2ULL << ( added % 64 ) ) - 1 ) ;
+		while( bits ){
+			int bit = 63 - __builtin_clzll( bits ) ;
+			bits &= ~( 1ULL << bit ) ;
+			VARSET_CLEAR( superset , 64 * word + bit ) ;
+			bool found = scores.find( superset ) != scores.end() ;
+			VARSET_SET( superset , 64 * word + bit ) ;
+			if( found ) return false ;
+		}
+	}
+	return true ;
+}
+
+void parentselection::ParallelSequentialSelection::initialize( int variable , FloatMap &pruned , FloatMap &cache ){
+	// Initialize closed
+	VARSET_NEW( empty , variableCount ) ;
+	VARSET_CLEAR_ALL( empty ) ;
+	float score = scoringFunction->calculateScore( variable , empty , pruned , cache ) ;
+	if( score < 1 ){
+		cache[ empty ] = score ;
+	}
+
+	// the first layer is generated from the empty set, which only counts as
+	// a kept subset if it was scored
+	options = constraints->getPossibleParents( variable ) ;
+	expanded.clear() ;
+	expandedScores.clear() ;
+	bool kept = score < 1 ;
+	if( !kept || scoringFunction->canImproveSupersets( variable , empty , score ) ){
+		expanded.push_back( empty ) ;
+		if( kept ) expandedScores[ empty ] = score ;
+	}
+	nextLayer( variable ) ;
+}
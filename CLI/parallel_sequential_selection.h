@@ -0,0 +1,61 @@
+/*
+ * File:   parallel_sequential_selection.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef PARALLEL_SEQUENTIAL_SELECTION_H
+#define	PARALLEL_SEQUENTIAL_SELECTION_H
+
+#include <vector>
+
+#include "parent_set_selection.h"
+
+namespace parentselection {
+	/**
+	 * The same breadth-first search as SequentialSelection, but the next
+	 * layer is also built in parallel.  Each parent set is generated only
+	 * from its canonical subset, the expanded one left by removing its
+	 * highest possible variable, so no two expanded sets generate the same
+	 * superset and the layer needs no lookups to remove repetitions.  The
+	 * bounds of a superset and its canonical subset are read from the kept
+	 * sets of the previous layer, which do not change while the layer is
+	 * built.
+	 */
+	class ParallelSequentialSelection : public ParentSetSelection {
+		public :
+			ParallelSequentialSelection( scoring::ScoringFunction *scoringFunction ,
+										int maxParents , int variableCount ,
+										int runningTime , scoring::Constraints *constraints ) ;
+
+		private :
+			void initialize( int variable , FloatMap &pruned , FloatMap &cache ) ;
+			void calculateScores_internal( int variable , FloatMap &pruned , FloatMap &cache ) ;
+			void scoreLayerItem( int index , int variable , std::vector<float> *scores ) ;
+			void expandItem( int index , int variable ) ;
+			bool isCanonicalSubset( varset &superset , int added ) ;
+			void nextLayer( int variable ) ;
+
+			// the parent sets of the current BFS layer, with the best score of
+			// any of their subsets and how many of their immediate subsets
+			// were kept
+			std::vector<varset> layer ;
+			std::vector<float> bestSubsetScores ;
+			std::vector<int> keptSubsets ;
+
+			// the sets of the previous layer which are expanded, and the best
+			// score of each of them and its subsets if it was kept
+			std::vector<varset> expanded ;
+			FloatMap expandedScores ;
+
+			// the supersets generated from each expanded set
+			std::vector< std::vector<varset> > children ;
+			std::vector< std::vector<float> > childBestSubsetScores ;
+			std::vector< std::vector<int> > childKeptSubsets ;
+
+			std::vector<int> options ;
+	} ;
+}
+
+#endif	/* PARALLEL_SEQUENTIAL_SELECTION_H */
@@ -8,6 +8,7 @@
 #include <boost/thread.hpp>
 
 #include "parent_set_selection.h"
+#include "subset_trie.h"
 
 struct compareSecond {
 	bool operator()( std::pair<varset,float> lhs , std::pair<varset,float> rhs ) const {
@@ -27,25 +28,29 @@ void parentselection::ParentSetSelection::prune( FloatMap &cache ){
 
 	std::sort( pairs.begin() , pairs.end() , comparatorPrune ) ;
 
-	// keep track of the ones that have been pruned
-	boost::dynamic_bitset<> prunedSets( pairs.size() ) ;
+	// a set is pruned if a better one kept so far is a subset of it
+	datastructures::SubsetTrie kept ;
 	for( int i = 0; i < pairs.size(); i++){
-		if( prunedSets.test( i ) ) continue ;
-
-		varset pi = pairs[ i ].first ;
-
-		for( int j = i + 1 ; j < pairs.size() ; j++){
-			if( prunedSets.test( j ) ) continue ;
+		if( kept.containsSubsetOf( pairs[ i ].first ) ){
+			cache.erase( pairs[ i ].first ) ;
+		}else{
+			kept.insert( pairs[ i ].first ) ;
+		}
+	}
+}
 
-			// check if parents[i] is a subset of parents[j]
-			varset pj = pairs[ j ].first ;
+/**
+ * Evaluate the items of a layer, through the scheduler if there is one so
+ * that idle scoring threads can help.
+ */
+void parentselection::ParentSetSelection::runLayer( int itemCount , boost::function<void (int)> item ){
+	if( scheduler != NULL ){
+		scheduler->runLayer( itemCount , item ) ;
+		return ;
+	}
 
-			if( VARSET_IS_SUBSET_OF( pi , pj ) ){
-				// then we can prune pj
-				prunedSets.set( j ) ;
-				cache.erase( pj ) ;
-			}
-		}
+	for( int i = 0 ; i < itemCount ; i++){
+		item( i ) ;
 	}
 }
 
@@ -9,22 +9,40 @@
 #define	PARENTSETSELECTION_H
 
 #include <boost/asio.hpp>
+#include <boost/function.hpp>
+
+#include <string>
 
 #include "scoring_function.h"
+#include "scoring_scheduler.h"
 #include "constraints.h"
 
 namespace parentselection {
 	class ParentSetSelection {
 		public :
+			ParentSetSelection() : scheduler( NULL ) , frontierMemory( 0 ) {}
+
 			void prune( FloatMap &cache ) ;
 			void timeout( const boost::system::error_code &/*e*/ ) ;
 			void calculateScores( int variable , FloatMap &cache ) ;
 			virtual void initialize( int variable , FloatMap &pruned , FloatMap &cache ) = 0 ;
+
+			void setScheduler( ScoringScheduler *scheduler ){
+				this->scheduler = scheduler ;
+			}
+
+			// Bytes of the search frontier kept in memory (0 for no limit),
+			// and where the rest goes
+			void setFrontier( size_t frontierMemory , std::string frontierFile ){
+				this->frontierMemory = frontierMemory ;
+				this->frontierFile = frontierFile ;
+			}
 		
 		protected :
 			virtual void calculateScores_internal( int variable , 
 													FloatMap &pruned ,
 													FloatMap &cache ) = 0 ;
+			void runLayer( int itemCount , boost::function<void (int)> item ) ;
 
 			boost::asio::io_service io ;
 			boost::asio::deadline_timer *t ;
@@ -35,6 +53,9 @@ namespace parentselection {
 			int variableCount ;
 			int runningTime ;
 			scoring::Constraints *constraints ;
+			ScoringScheduler *scheduler ;
+			size_t frontierMemory ;
+			std::string frontierFile ;
 	} ;
 }
 
@@ -10,12 +10,13 @@
 
 #include "scoring_function.h"
 #include "sequential_selection.h"
+#include "parallel_sequential_selection.h"
 #include "greedy_selection.h"
 #include "independence_selection.h"
 
 namespace parentselection {
     
-	static std::string parentSetSelectionString = "The method to selecting parent sets. [\"sequential\", \"greedy\", \"independence\"]";
+	static std::string parentSetSelectionString = "The method to selecting parent sets. [\"sequential\", \"parallel_sequential\", \"greedy\", \"independence\"]";
 
 	inline ParentSetSelection* create( std::string type , scoring::ScoringFunction *scoringFunction ,
 										int maxParents , int variableCount , int runningTime ,
@@ -23,12 +24,14 @@ namespace parentselection {
 		ParentSetSelection *pss ;
 		if( type == "sequential" ){
 			pss = new SequentialSelection( scoringFunction , maxParents , variableCount , runningTime , constraints ) ;
+		}else if( type == "parallel_sequential" ){
+			pss = new ParallelSequentialSelection( scoringFunction , maxParents , variableCount , runningTime , constraints ) ;
 		}else if( type == "greedy" ){
 			pss = new GreedySelection( scoringFunction , maxParents , variableCount , runningTime , constraints ) ;
 		}else if( type == "independence" ){
 			pss = new IndependenceSelection( scoringFunction , maxParents , variableCount , runningTime , constraints ) ;
 		}else{
-			throw std::runtime_error( "Invalid PS selection: '" + type + "'.  Valid options are 'sequential', 'greedy' and 'independence'.");
+			throw std::runtime_error( "Invalid PS selection: '" + type + "'.  Valid options are 'sequential', 'parallel_sequential', 'greedy' and 'independence'.");
 		}
 		return pss ;
 	}
@@ -0,0 +1,83 @@
+/*
+ * File:   partition_cache.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <algorithm>
+
+#include "partition_cache.h"
+
+boost::shared_ptr<scoring::Partition> scoring::Partition::refine( const std::vector<uint16_t> &column , int cardinality ) const {
+	boost::shared_ptr<Partition> refined( new Partition() ) ;
+	refined->records.resize( records.size() ) ;
+	refined->starts.reserve( starts.size() * 2 ) ;
+	refined->starts.push_back( 0 ) ;
+
+	// counting sort of each group on the value of the column
+	std::vector<uint32_t> offsets( cardinality + 1 ) ;
+	for( int g = 0 ; g < groupCount() ; g++){
+		std::fill( offsets.begin() , offsets.end() , 0 ) ;
+		for( uint32_t r = starts[ g ] ; r < starts[ g + 1 ] ; r++){
+			offsets[ column[ records[ r ] ] + 1 ]++ ;
+		}
+
+		uint32_t start = starts[ g ] ;
+		for( int k = 0 ; k < cardinality ; k++){
+			uint32_t size = offsets[ k + 1 ] ;
+			offsets[ k + 1 ] = offsets[ k ] + size ;
+			if( size > 0 ){
+				refined->starts.push_back( start + offsets[ k + 1 ] ) ;
+			}
+		}
+
+		for( uint32_t r = starts[ g ] ; r < starts[ g + 1 ] ; r++){
+			uint32_t record = records[ r ] ;
+			refined->records[ start + offsets[ column[ record ] ]++ ] = record ;
+		}
+	}
+
+	return refined ;
+}
+
+boost::shared_ptr<scoring::Partition> scoring::Partition::all( int recordCount ){
+	boost::shared_ptr<Partition> partition( new Partition() ) ;
+	partition->records.resize( recordCount ) ;
+	for( int r = 0 ; r < recordCount ; r++){
+		partition->records[ r ] = r ;
+	}
+	partition->starts.push_back( 0 ) ;
+	partition->starts.push_back( recordCount ) ;
+	return partition ;
+}
+
+scoring::PartitionCache::PartitionCache( size_t maxBytes ){
+	this->bytes = 0 ;
+	this->maxBytes = maxBytes ;
+}
+
+scoring::PartitionPtr scoring::PartitionCache::get( varset &parents ){
+	boost::shared_lock<boost::shared_mutex> lock( mutex ) ;
+	auto it = partitions.find( parents ) ;
+	if( it == partitions.end() ) return PartitionPtr() ;
+	return it->second ;
+}
+
+void scoring::PartitionCache::put( varset &parents , PartitionPtr partition ){
+	if( partition->bytes() > maxBytes ) return ;
+
+	boost::unique_lock<boost::shared_mutex> lock( mutex ) ;
+	if( partitions.count( parents ) > 0 ) return ;
+
+	while( bytes + partition->bytes() > maxBytes ){
+		auto oldest = partitions.find( insertionOrder.front() ) ;
+		bytes -= oldest->second->bytes() ;
+		partitions.erase( oldest ) ;
+		insertionOrder.pop_front() ;
+	}
+
+	partitions[ parents ] = partition ;
+	insertionOrder.push_back( parents ) ;
+	bytes += partition->bytes() ;
+}
@@ -0,0 +1,73 @@
+/*
+ * File:   partition_cache.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef PARTITION_CACHE_H
+#define	PARTITION_CACHE_H
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "typedefs.h"
+
+namespace scoring {
+
+	/**
+	 * The records of the data set grouped by the configuration of a parent
+	 * set.  The records of group g are records[ starts[ g ] , starts[ g + 1 ] );
+	 * only non-empty groups are kept.
+	 */
+	struct Partition {
+		std::vector<uint32_t> records ;
+		std::vector<uint32_t> starts ;
+
+		int groupCount() const {
+			return starts.size() - 1 ;
+		}
+
+		size_t bytes() const {
+			return ( records.size() + starts.size() ) * sizeof( uint32_t ) ;
+		}
+
+		/**
+		 * Split every group on the values of {@code column}.
+		 */
+		boost::shared_ptr<Partition> refine( const std::vector<uint16_t> &column , int cardinality ) const ;
+
+		static boost::shared_ptr<Partition> all( int recordCount ) ;
+	} ;
+
+	typedef boost::shared_ptr<const Partition> PartitionPtr ;
+
+	/**
+	 * A bounded cache of partitions keyed by parent set, shared by the
+	 * scoring threads.  A superset which adds one variable to a cached set is
+	 * partitioned by refining the cached partition instead of counting from
+	 * scratch.  The oldest partitions are dropped first once the cache is
+	 * over its size; the ones still in use are kept alive by their pointers.
+	 */
+	class PartitionCache {
+		public :
+			PartitionCache( size_t maxBytes ) ;
+
+			PartitionPtr get( varset &parents ) ;
+			void put( varset &parents , PartitionPtr partition ) ;
+
+		private :
+			boost::shared_mutex mutex ;
+			boost::unordered_map<varset, PartitionPtr> partitions ;
+			std::deque<varset> insertionOrder ;
+			size_t bytes ;
+			size_t maxBytes ;
+	} ;
+}
+
+#endif	/* PARTITION_CACHE_H */
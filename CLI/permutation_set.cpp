@@ -10,10 +10,11 @@
 #include <boost/random.hpp>
 
 #include "permutation_set.h"
+#include "bn_structure.h"
 #include "utils.h"
 
 structureoptimizer::PermutationSet::PermutationSet(){
-	// Do nothing
+	this->structure = NULL ;
 }
 
 structureoptimizer::PermutationSet::PermutationSet( const structureoptimizer::PermutationSet &other ){
@@ -22,10 +23,32 @@ structureoptimizer::PermutationSet::PermutationSet( const structureoptimizer::Pe
 		permutation.push_back( other[ i ] ) ;
 	this->bestScoreCalculator = other.getBestScoreCalculators() ;
 	this->score = other.getScore() ;
+	this->parentIndices = other.parentIndices ;
+	this->positionScores = other.positionScores ;
+	this->prefixes = other.prefixes ;
+	this->structure = other.structure != NULL ? new datastructures::BNStructure( *other.structure ) : NULL ;
 }
 
 structureoptimizer::PermutationSet::~PermutationSet(){
-	// Do nothing
+	delete structure ;
+}
+
+void structureoptimizer::PermutationSet::copyFrom( const structureoptimizer::PermutationSet &other ){
+	if( this == &other ) return ;
+	this->permutation = other.permutation ;
+	this->bestScoreCalculator = other.bestScoreCalculator ;
+	this->score = other.score ;
+	this->parentIndices = other.parentIndices ;
+	this->positionScores = other.positionScores ;
+	this->prefixes = other.prefixes ;
+	if( other.structure == NULL ){
+		delete structure ;
+		structure = NULL ;
+	}else if( structure == NULL ){
+		structure = new datastructures::BNStructure( *other.structure ) ;
+	}else{
+		*structure = *other.structure ;
+	}
 }
 
 float structureoptimizer::PermutationSet::getScore() const {
@@ -74,6 +97,22 @@ void structureoptimizer::PermutationSet::swap( int idx1 , int idx2 ){
 	isAdjacentMove ? updateScore( std::min( idx1 , idx2 ) ) : updateScore() ;
 }
 
+float structureoptimizer::PermutationSet::evaluateSwap( int idx ){
+	applySwap( idx ) ;
+	float newScore = score ;
+	undoSwap( idx ) ;
+	return newScore ;
+}
+
+void structureoptimizer::PermutationSet::applySwap( int idx ){
+	swap( idx , idx + 1 ) ;
+}
+
+void structureoptimizer::PermutationSet::undoSwap( int idx ){
+	swap( idx , idx + 1 ) ;
+}
+
+// Built from the order, a subclass may not keep prefixes current
 varset structureoptimizer::PermutationSet::getVarset( int index ){
 	VARSET_NEW( vset , permutation.size() ) ;
 	VARSET_CLEAR_ALL( vset ) ;
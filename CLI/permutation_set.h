@@ -22,7 +22,11 @@ namespace structureoptimizer {
 		public :
 			PermutationSet() ;
 			PermutationSet( const PermutationSet &other ) ;
-			~PermutationSet() ;
+			virtual ~PermutationSet() ;
+
+			// Take the order and scores of other, a set of the same type,
+			// reusing the memory of this one
+			virtual void copyFrom( const PermutationSet &other ) ;
 
 			int operator [] ( int idx ) const ;
 			bool operator < ( PermutationSet &other ) const ;
@@ -30,6 +34,11 @@ namespace structureoptimizer {
 
 			void swap( int idx1 , int idx2 ) ;
 
+			// Moves between neighbours, swapping the variables at idx and idx + 1
+			virtual float evaluateSwap( int idx ) ; // Score after the move, the set does not change
+			virtual void applySwap( int idx ) ;
+			virtual void undoSwap( int idx ) ; // Only after applySwap( idx ), as the last change
+
 			float getScore() const ;
 			bool isBetter( PermutationSet &other ) ;
 
@@ -57,6 +66,18 @@ namespace structureoptimizer {
 			std::vector<int> permutation ;
 			std::vector<bestscorecalculators::BestScoreCalculator*> bestScoreCalculator ;
 			float score ;
+
+			// for each position, the index of the best parent set of its
+			// variable among the previous ones and its score, so adjacent
+			// swaps can be rescored incrementally
+			std::vector<int> parentIndices ;
+			std::vector<float> positionScores ;
+
+			// prefixes[ i ] holds the variables before position i, for the
+			// sets which keep it up to date; empty otherwise
+			std::vector<varset> prefixes ;
+
+			// owned by the set, every copy gets its own; NULL until needed
 			datastructures::BNStructure* structure ;
 	} ;
 }
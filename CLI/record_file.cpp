@@ -0,0 +1,202 @@
+/*
+ * File:   record_file.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/thread.hpp>
+
+#include "record_file.h"
+
+// the characters removed by boost::trim in the classic locale
+static bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// trim [begin, end) the same way as boost::trim
+static void trim(const char *&begin, const char *&end) {
+	while (begin < end && isSpace(*begin)) {
+		begin++;
+	}
+	while (end > begin && isSpace(*(end - 1))) {
+		end--;
+	}
+}
+
+static const char *nextLine(const char *begin, const char *end) {
+	const char *newline = std::find(begin, end, '\n');
+	return (newline == end ? end : newline + 1);
+}
+
+void datastructures::RecordFile::read(int threadCount) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Could not open data file: '" + filename + "'");
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		throw std::runtime_error("Could not read data file: '" + filename + "'");
+	}
+
+	size_t length = st.st_size;
+	const char *data = NULL;
+	if (length > 0) {
+		void *mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Could not map data file: '" + filename + "'");
+		}
+		madvise(mapped, length, MADV_SEQUENTIAL);
+		data = (const char*) mapped;
+	}
+	close(fd);
+
+	const char *begin = data;
+	const char *end = data + length;
+
+	if (hasHeader) {
+		const char *lineEnd = nextLine(begin, end);
+		std::string line(begin, lineEnd);
+		header = Record(line, delimiter);
+		begin = lineEnd;
+	}
+
+	// the first record fixes the number of columns
+	columns.clear();
+	recordCount = 0;
+	while (begin < end && columns.size() == 0) {
+		const char *lineEnd = nextLine(begin, end);
+		const char *lineBegin = begin;
+		const char *lineLast = lineEnd;
+		trim(lineBegin, lineLast);
+
+		if (lineBegin == lineLast) {
+			begin = lineEnd;
+			continue;
+		}
+
+		int count = 1;
+		for (const char *c = lineBegin; c < lineLast; c++) {
+			if (*c != delimiter) {
+				continue;
+			}
+			count++;
+			while (c + 1 < lineLast && *(c + 1) == delimiter) {
+				c++;
+			}
+		}
+		columns.resize(count);
+	}
+
+	// cut the records into chunks which start right after a newline
+	if (threadCount < 1) {
+		threadCount = 1;
+	}
+	std::vector<Chunk> chunks(threadCount);
+	size_t chunkLength = (end - begin) / threadCount;
+	for (int c = 0; c < threadCount; c++) {
+		chunks[c].begin = (c == 0 ? begin : chunks[c - 1].end);
+		if (c == threadCount - 1) {
+			chunks[c].end = end;
+		} else {
+			const char *target = std::max(chunks[c].begin, begin + chunkLength * (c + 1));
+			chunks[c].end = (target == begin ? begin : nextLine(target - 1, end));
+		}
+		chunks[c].columns.resize(columns.size());
+		chunks[c].recordCount = 0;
+	}
+
+	if (threadCount == 1) {
+		readChunk(chunks[0]);
+	} else {
+		std::vector<boost::thread*> threads;
+		for (int c = 0; c < threadCount; c++) {
+			threads.push_back(new boost::thread(&RecordFile::readChunk, this, boost::ref(chunks[c])));
+		}
+		for (auto it = threads.begin(); it != threads.end(); it++) {
+			(*it)->join();
+			delete *it;
+		}
+	}
+
+	if (data != NULL) {
+		munmap((void*) data, length);
+	}
+
+	// merge the chunks in file order
+	for (auto chunk = chunks.begin(); chunk != chunks.end(); chunk++) {
+		if (chunk->error.size() > 0) {
+			throw std::runtime_error(chunk->error);
+		}
+		for (int column = 0; column < columns.size(); column++) {
+			columns[column].append(chunk->columns[column]);
+		}
+		recordCount += chunk->recordCount;
+		chunk->columns.clear();
+	}
+}
+
+void datastructures::RecordFile::readChunk(Chunk &chunk) {
+	std::string token;
+	const char *begin = chunk.begin;
+	while (begin < chunk.end) {
+		const char *lineEnd = nextLine(begin, chunk.end);
+		const char *lineBegin = begin;
+		const char *lineLast = lineEnd;
+		trim(lineBegin, lineLast);
+		begin = lineEnd;
+
+		if (lineBegin == lineLast) {
+			continue;
+		}
+
+		try {
+			addLine(chunk, lineBegin, lineLast, token);
+		} catch (std::runtime_error &e) {
+			chunk.error = e.what();
+			return;
+		}
+	}
+}
+
+/**
+ * Split [begin, end) on the delimiter, treating consecutive delimiters as
+ * one, and append each token to its column of the chunk.
+ */
+void datastructures::RecordFile::addLine(Chunk &chunk, const char *begin, const char *end, std::string &token) {
+	int column = 0;
+	const char *start = begin;
+	for (const char *c = begin; c <= end; c++) {
+		if (c < end && *c != delimiter) {
+			continue;
+		}
+
+		if (column == chunk.columns.size()) {
+			throw std::runtime_error("Too many values in record: '" + std::string(begin, end) + "'");
+		}
+
+		token.assign(start, c - start);
+		chunk.columns[column++].push_back(token);
+
+		while (c + 1 < end && *(c + 1) == delimiter) {
+			c++;
+		}
+		start = c + 1;
+	}
+
+	if (column != chunk.columns.size()) {
+		throw std::runtime_error("Too few values in record: '" + std::string(begin, end) + "'");
+	}
+	chunk.recordCount++;
+}
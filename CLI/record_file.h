@@ -8,11 +8,10 @@
 #ifndef RECORD_FILE_H
 #define	RECORD_FILE_H
 
-#include <iostream>
-#include <fstream>
 #include <string>
 #include <vector>
 
+#include "data_column.h"
 #include "record.h"
 
 namespace datastructures {
@@ -24,37 +23,42 @@ namespace datastructures {
 				filename = "";
 				delimiter = ',';
 				hasHeader = false;
+				recordCount = 0;
 			}
 
 			RecordFile(std::string filename, char delimiter, bool hasHeader) {
 				this->filename = filename;
 				this->delimiter = delimiter;
 				this->hasHeader = hasHeader;
+				this->recordCount = 0;
 			}
 
 			~RecordFile() {
-				records.clear();
+				columns.clear();
 			}
 
-			void read() {
-				std::ifstream file(filename);
-
-				std::string line;
-
-				if (hasHeader) {
-					std::getline(file, line);
-					boost::algorithm::trim(line);
-					header = Record(line, delimiter);
-				}
+			/**
+			 * Read the data file.
+			 *
+			 * The file is memory-mapped and cut into {@code threadCount} chunks
+			 * at line boundaries. Each chunk is tokenized and encoded by its own
+			 * thread, and the chunks are then merged in file order, so the value
+			 * indices are the same as when reading the file line by line.
+			 *
+			 * @param threadCount the number of threads used to parse the records
+			 */
+			void read(int threadCount = 1);
+
+			DataColumn &getColumn(int index) {
+				return columns[index];
+			}
 
-				while (std::getline(file, line)) {
-					boost::algorithm::trim(line);
-					records.push_back(Record(line, delimiter));
-				}
+			std::vector<DataColumn> &getColumns() {
+				return columns;
 			}
 
-			std::vector<Record> &getRecords() {
-				return records;
+			int getColumnCount() {
+				return columns.size();
 			}
 
 			bool getHasHeader() {
@@ -66,17 +70,29 @@ namespace datastructures {
 			}
 
 			int size() {
-				return records.size();
+				return recordCount;
 			}
 
 		private:
+
+			struct Chunk {
+				const char *begin;
+				const char *end;
+				std::vector<DataColumn> columns;
+				int recordCount;
+				std::string error;
+			};
+
+			void readChunk(Chunk &chunk);
+			void addLine(Chunk &chunk, const char *begin, const char *end, std::string &token);
+
 			std::string filename;
 			char delimiter;
 			bool hasHeader;
 			Record header;
-			std::vector<Record> records;
+			std::vector<DataColumn> columns;
+			int recordCount;
 	} ;
 }
 
 #endif	/* RECORD_FILE_H */
-
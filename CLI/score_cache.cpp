@@ -3,6 +3,12 @@
 #include "bayesian_network.h"
 #include "variable.h"
 
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <fstream>
 #include <iostream>
 
@@ -47,13 +53,123 @@ bool contains(std::string line, std::string str) {
 void scoring::ScoreCache::read(std::string filename) {
 	network = new datastructures::BayesianNetwork();
 
-	std::ifstream in(filename.c_str());
+	std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
 
 	// make sure we found the file
 	if (!in.is_open()) {
 		throw std::runtime_error("Could not open the score cache file: '" + filename + "'");
 	}
 
+	// binary files start with the magic string, text files with META lines
+	char magic[SCORE_FILE_MAGIC_LENGTH];
+	in.read(magic, SCORE_FILE_MAGIC_LENGTH);
+	bool binary = (in.gcount() == SCORE_FILE_MAGIC_LENGTH && memcmp(magic, SCORE_FILE_MAGIC, SCORE_FILE_MAGIC_LENGTH) == 0);
+	in.close();
+
+	if (binary) {
+		readBinary(filename);
+	} else {
+		readText(filename);
+	}
+
+	printf("sc( empty ) = %.6lf\n" , getEmptyNetworkScore() ) ;
+}
+
+void scoring::ScoreCache::readBinary(std::string filename) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Could not open the score cache file: '" + filename + "'");
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		throw std::runtime_error("Could not read the size of the score cache file: '" + filename + "'");
+	}
+	size_t length = st.st_size;
+	void *mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		throw std::runtime_error("Could not map the score cache file: '" + filename + "'");
+	}
+	madvise(mapped, length, MADV_SEQUENTIAL);
+
+	try {
+		readBinary(filename, (const char*) mapped, (const char*) mapped + length);
+	} catch (...) {
+		munmap(mapped, length);
+		throw;
+	}
+	munmap(mapped, length);
+}
+
+void scoring::ScoreCache::readBinary(std::string filename, const char *data, const char *end) {
+	data += SCORE_FILE_MAGIC_LENGTH;
+	int version = readInt(data, end);
+	if (version != SCORE_FILE_VERSION) {
+		throw std::runtime_error("Unsupported score cache version " + TO_STRING(version) + " in: '" + filename + "'");
+	}
+
+	int variableCount = readInt(data, end);
+	int words = readInt(data, end);
+	if (variableCount < 0 || words != getMaskWordCount(variableCount)) {
+		throw std::runtime_error("Invalid number of variables or mask words in: '" + filename + "'");
+	}
+
+	int metaCount = readInt(data, end);
+	for (int i = 0; i < metaCount; i++) {
+		std::string key = readString(data, end);
+		std::string value = readString(data, end);
+		updateMetaInformation(key, value);
+	}
+
+	// the bits above the last variable must be clear
+	uint64_t lastWordMask = variableCount % 64 == 0 ? ~0ULL : (1ULL << (variableCount % 64)) - 1;
+
+	setVariableCount(variableCount);
+	for (int variable = 0; variable < variableCount; variable++) {
+		datastructures::Variable *v = network->addVariable(readString(data, end));
+		v->setArity(readInt(data, end));
+
+		int valueCount = readInt(data, end);
+		if (valueCount < 0) {
+			throw std::runtime_error("Invalid number of values in: '" + filename + "'");
+		}
+		std::vector<std::string> values(valueCount);
+		for (int i = 0; i < values.size(); i++) {
+			values[i] = readString(data, end);
+		}
+		v->setValues(values);
+
+		// check the whole block first, so a corrupt count does not reserve too much
+		uint64_t scoreCount = readLong(data, end);
+		uint64_t scoreSize = words * sizeof (uint64_t) + sizeof (float);
+		if (scoreCount > (uint64_t) (end - data) / scoreSize) {
+			throw std::runtime_error("Unexpected end of the score cache file: '" + filename + "'");
+		}
+
+		FloatMap *scores = cache[variable];
+		scores->reserve(scoreCount);
+		for (uint64_t s = 0; s < scoreCount; s++) {
+			VARSET_NEW(parents, variableCount);
+			for (int w = 0; w < words; w++) {
+				uint64_t mask = readLong(data, end);
+				if (w == words - 1 && (mask & ~lastWordMask) != 0) {
+					throw std::runtime_error("Parent set with unknown variables in: '" + filename + "'");
+				}
+				while (mask != 0) {
+					VARSET_SET(parents, w * 64 + __builtin_ctzll(mask));
+					mask &= mask - 1;
+				}
+			}
+			(*scores)[parents] = -1 * readFloat(data, end); // multiply by -1 to minimize
+		}
+	}
+}
+
+void scoring::ScoreCache::readText(std::string filename) {
+	std::ifstream in(filename.c_str());
+
 	std::vector<std::string> tokens;
 	std::string line;
 
@@ -151,7 +267,6 @@ void scoring::ScoreCache::read(std::string filename) {
 	}
 
 	in.close();
-	printf("sc( empty ) = %.6lf\n" , getEmptyNetworkScore() ) ;
 }
 
 float scoring::ScoreCache::getEmptyNetworkScore(){
@@ -105,6 +105,10 @@ namespace scoring {
 			float getEmptyNetworkScore() ;
 			
 		private:
+			void readText(std::string filename);
+			void readBinary(std::string filename);
+			void readBinary(std::string filename, const char *data, const char *end);
+
 			int variableCount;
 			datastructures::BayesianNetwork *network;
 			std::vector<int> variableCardinalities;
@@ -18,6 +18,15 @@ namespace scoring {
 		public:
 			virtual float calculateScore( int variable , varset parents ,
 											FloatMap &pruned , FloatMap &cache ) = 0 ;
+			// For a breadth-first search which passes the bounds on from the
+			// subsets: the best score of any subset of parents, and how many
+			// of its immediate subsets were kept.  Returns 1 if it is pruned
+			virtual float calculateScore( int variable , varset parents ,
+											float bestSubsetScore , int keptSubsets ) = 0 ;
+			// Whether a strict superset of parents may score better than
+			// bestScore, the best score of parents and its subsets; if not,
+			// the search does not need to expand parents
+			virtual bool canImproveSupersets( int variable , varset &parents , float bestScore ) = 0 ;
 			virtual approxStruct approximateScore( int variable , varset parents ,
 													FloatMap &pruned , FloatMap &cache ,
 													ApproxMap &openCache ) = 0 ;
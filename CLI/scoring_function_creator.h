@@ -25,12 +25,15 @@ namespace scoring {
 									datastructures::BayesianNetwork &network ,
 									datastructures::RecordFile &recordFile ,
 									Constraints *constraints ,
-									bool whileCalculatingPruning ){
+									bool whileCalculatingPruning ,
+									int partitionCacheSize ){
 		ScoringFunction *scoringFunction ;
 		boost::algorithm::to_lower( sf ) ;
 		if( sf == "bic" ){
 			std::vector<float> ilogi = LogLikelihoodCalculator::getLogCache( recordFile.size() ) ;
 			LogLikelihoodCalculator *llc = new LogLikelihoodCalculator( adTree , network , ilogi ) ;
+			llc->setRecords( recordFile ) ;
+			llc->setPartitionCacheSize( ( size_t ) partitionCacheSize << 20 ) ;
 			scoringFunction = new BICScoringFunction( network , recordFile , llc , constraints , whileCalculatingPruning ) ;
 		}else{
 			throw std::runtime_error( "Invalid PS selection: '" + sf + "'.  Valid options are 'sequential', 'greedy' and 'independence'.");
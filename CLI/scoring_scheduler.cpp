@@ -0,0 +1,84 @@
+/*
+ * File:   scoring_scheduler.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include "scoring_scheduler.h"
+
+parentselection::ScoringScheduler::ScoringScheduler( int variableCount , int threadCount ){
+	this->variableCount = variableCount ;
+	this->nextVariableIndex = 0 ;
+	this->busyThreads = threadCount ;
+}
+
+int parentselection::ScoringScheduler::nextVariable(){
+	boost::unique_lock<boost::mutex> lock( mutex ) ;
+	if( nextVariableIndex < variableCount ){
+		return nextVariableIndex++ ;
+	}
+
+	// this thread will not post any more layers
+	busyThreads-- ;
+	changed.notify_all() ;
+	return -1 ;
+}
+
+void parentselection::ScoringScheduler::help(){
+	boost::unique_lock<boost::mutex> lock( mutex ) ;
+	while( true ){
+		Layer *layer = NULL ;
+		for( auto it = layers.begin() ; it != layers.end() ; it++){
+			if( ( *it )->next < ( *it )->itemCount ){
+				layer = *it ;
+				break ;
+			}
+		}
+
+		if( layer != NULL ){
+			// the owner waits for its helpers before it drops the layer
+			layer->helpers++ ;
+			lock.unlock() ;
+			work( layer ) ;
+			lock.lock() ;
+			layer->helpers-- ;
+			changed.notify_all() ;
+			continue ;
+		}
+
+		if( busyThreads == 0 ) return ;
+		changed.wait( lock ) ;
+	}
+}
+
+void parentselection::ScoringScheduler::runLayer( int itemCount , boost::function<void (int)> item ){
+	Layer layer ;
+	layer.itemCount = itemCount ;
+	layer.item = item ;
+	layer.next = 0 ;
+	layer.helpers = 0 ;
+
+	{
+		boost::unique_lock<boost::mutex> lock( mutex ) ;
+		layers.push_back( &layer ) ;
+		changed.notify_all() ;
+	}
+
+	work( &layer ) ;
+
+	// every item has been taken; wait for the helpers still running one
+	boost::unique_lock<boost::mutex> lock( mutex ) ;
+	layers.remove( &layer ) ;
+	while( layer.helpers > 0 ){
+		changed.wait( lock ) ;
+	}
+}
+
+void parentselection::ScoringScheduler::work( Layer *layer ){
+	while( true ){
+		int index = layer->next++ ;
+		if( index >= layer->itemCount ) return ;
+		layer->item( index ) ;
+	}
+}
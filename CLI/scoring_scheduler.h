@@ -0,0 +1,70 @@
+/*
+ * File:   scoring_scheduler.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SCORING_SCHEDULER_H
+#define	SCORING_SCHEDULER_H
+
+#include <list>
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+namespace parentselection {
+
+	/**
+	 * Shares the work of parent set selection between the scoring threads.
+	 *
+	 * Variables are handed out one at a time, so a thread which finishes a
+	 * cheap variable simply takes the next one.  Once no variables are left,
+	 * the thread calls help() and works on the BFS layers that the threads
+	 * still busy with a variable post through runLayer().
+	 */
+	class ScoringScheduler {
+		public :
+			ScoringScheduler( int variableCount , int threadCount ) ;
+
+			/**
+			 * Get the next variable to score.  When every variable has been
+			 * handed out, -1 is returned and the calling thread should call
+			 * help() instead of asking again.
+			 */
+			int nextVariable() ;
+
+			/**
+			 * Evaluate the items of the posted layers until all of the other
+			 * threads are out of variables.
+			 */
+			void help() ;
+
+			/**
+			 * Call item( 0 ) ... item( itemCount - 1 ), sharing the calls with
+			 * any helping threads, and return once all of them are done.  The
+			 * calls may run concurrently and in any order.
+			 */
+			void runLayer( int itemCount , boost::function<void (int)> item ) ;
+
+		private :
+			struct Layer {
+				int itemCount ;
+				boost::function<void (int)> item ;
+				boost::atomic<int> next ;
+				int helpers ;
+			} ;
+
+			void work( Layer *layer ) ;
+
+			boost::mutex mutex ;
+			boost::condition_variable changed ;
+			std::list<Layer*> layers ;
+			int variableCount ;
+			int nextVariableIndex ;
+			int busyThreads ;
+	} ;
+}
+
+#endif	/* SCORING_SCHEDULER_H */
@@ -4,9 +4,12 @@
  * 
  * Created on 13 de marzo de 2016, 08:49 PM
  */
+#include <boost/bind.hpp>
 #include <boost/thread.hpp>
 
-#include <queue>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "utils.h"
 #include "sequential_selection.h"
@@ -23,37 +26,89 @@ parentselection::SequentialSelection::SequentialSelection( scoring::ScoringFunct
 
 void parentselection::SequentialSelection::calculateScores_internal( int variable , FloatMap &pruned , FloatMap& cache ){
 	int prunedCount = 0 ;
-	std::vector<int> options = constraints->getPossibleParents( variable ) ;
-	while( !open.empty() && !outOfTime ){
-		varset parents = open.front() ; open.pop() ;
-		float score = scoringFunction->calculateScore( variable , parents , pruned , cache ) ;
-		if( compare( score ) < 0 ){
-			cache[ parents ] = score ;
-		}else{
-			prunedCount++ ;
-		}
-		
-		if( cardinality( parents ) >= maxParents ) continue ;
-		
-		// Expand parent set
-		VARSET_NEW( superset , variableCount ) ;
-		superset = parents ;
-		for(int i = 0 ; i < options.size() && !outOfTime ; i++){
-			if( options[ i ] == variable ) continue ;
-			VARSET_SET( superset , options[ i ] ) ;
-			// Expand only if it is not already visited/calculated
-			if( constraints->satisfiesConstraints( variable , superset ) ){
-				if( !cache.count( superset ) && !openCache.count( superset ) ){
-					open.push( superset ) ;
-					openCache[ superset ] = 0.0 ;
+	while( !reading->empty() && !outOfTime ){
+		// score the layer a chunk at a time; every subset of its parent sets
+		// is already in the cache, so the sets do not depend on each other
+		reading->finish() ;
+		while( !outOfTime && readChunk() ){
+			std::vector<float> scores( layer.size() , 1 ) ;
+			runLayer( layer.size() ,
+					boost::bind( &parentselection::SequentialSelection::scoreLayerItem ,
+								this , _1 , variable , &cache , &scores ) ) ;
+
+			reserve_map( cache , cache.size() + layer.size() ) ;
+			for(int l = 0 ; l < layer.size() ; l++){
+				if( compare( scores[ l ] ) < 0 ){
+					cache[ layer[ l ] ] = scores[ l ] ;
+					// the supersets of a pruned set are pruned too, so only kept ones are expanded
+					float bestScore = std::max( scores[ l ] , bestSubsetScores[ l ] ) ;
+					if( scoringFunction->canImproveSupersets( variable , layer[ l ] , bestScore ) )
+						expand( variable , layer[ l ] , bestScore , true ) ;
+				}else{
+					prunedCount++ ;
 				}
 			}
-			VARSET_CLEAR( superset , options[ i ] ) ;
 		}
+		reading->clear() ;
+		std::swap( reading , expanding ) ;
 	}
+	// nothing is left on disk if the time runs out
+	reading->clear() ;
+	expanding->clear() ;
+	layer.clear() ;
+	bestSubsetScores.clear() ;
+	keptSubsets.clear() ;
     t->cancel() ;
 }
 
+/**
+ * Read the next sets of the layer being scored, as many as fit in the
+ * memory given to them.
+ */
+bool parentselection::SequentialSelection::readChunk(){
+	layer.clear() ;
+	bestSubsetScores.clear() ;
+	keptSubsets.clear() ;
+
+	VARSET_NEW( parents , variableCount ) ;
+	float bestSubsetScore ;
+	int kept ;
+	while( layer.size() < chunkSize && reading->next( parents , bestSubsetScore , kept ) ){
+		layer.push_back( parents ) ;
+		bestSubsetScores.push_back( bestSubsetScore ) ;
+		keptSubsets.push_back( kept ) ;
+	}
+	return !layer.empty() ;
+}
+
+void parentselection::SequentialSelection::scoreLayerItem( int index , int variable , FloatMap *cache , std::vector<float> *scores ){
+	if( outOfTime ) return ;
+
+	// the bounds come from the subsets, so the cache is not looked up
+	( *scores )[ index ] = scoringFunction->calculateScore( variable , layer[ index ] ,
+															bestSubsetScores[ index ] , keptSubsets[ index ] ) ;
+}
+
+/**
+ * Add the supersets of {@code parents} with one more variable to the next
+ * layer, passing on the best subset score.  A superset reached from several
+ * subsets keeps the best of their scores and counts the kept ones once the
+ * layer is read back.
+ */
+void parentselection::SequentialSelection::expand( int variable , varset parents , float bestSubsetScore , bool kept ){
+	if( cardinality( parents ) >= maxParents ) return ;
+
+	VARSET_NEW( superset , variableCount ) ;
+	superset = parents ;
+	for(int i = 0 ; i < options.size() && !outOfTime ; i++){
+		if( options[ i ] == variable || VARSET_GET( parents , options[ i ] ) ) continue ;
+		VARSET_SET( superset , options[ i ] ) ;
+		if( constraints->satisfiesConstraints( variable , superset ) )
+			expanding->add( superset , bestSubsetScore , kept ) ;
+		VARSET_CLEAR( superset , options[ i ] ) ;
+	}
+}
+
 void parentselection::SequentialSelection::initialize( int variable , FloatMap &pruned , FloatMap &cache ){
 	// Initialize closed
 	VARSET_NEW( empty , variableCount ) ;
@@ -63,9 +118,22 @@ void parentselection::SequentialSelection::initialize( int variable , FloatMap &
 		cache[ empty ] = score ;
 	}
 
-	// Initialize open
-	std::queue<varset> aux ;
-	open = aux ;
-	open.push( empty ) ;
-	openCache.clear() ;
-}
\ No newline at end of file
+	// the budget is shared by the layer being read, the one being filled and
+	// the sets being scored
+	size_t budget = frontierMemory > 0 ? std::max( frontierMemory / 3 , (size_t) 1 ) : 0 ;
+	chunkSize = std::numeric_limits<size_t>::max() ;
+	if( frontierMemory > 0 )
+		chunkSize = std::max( budget / ( sizeof( varset ) + sizeof( float ) + sizeof( int ) ) , (size_t) 1 ) ;
+	layers[ 0 ].reset( variableCount , budget , frontierFile + ".a" ) ;
+	layers[ 1 ].reset( variableCount , budget , frontierFile + ".b" ) ;
+	reading = &layers[ 0 ] ;
+	expanding = &layers[ 1 ] ;
+
+	// Initialize open with the sets of one parent; the empty set is expanded
+	// even if the constraints skip it
+	options = constraints->getPossibleParents( variable ) ;
+	bool kept = score < 1 ;
+	if( !kept || scoringFunction->canImproveSupersets( variable , empty , score ) )
+		expand( variable , empty , kept ? score : -std::numeric_limits<float>::max() , kept ) ;
+	std::swap( reading , expanding ) ;
+}
@@ -8,9 +8,10 @@
 #ifndef SEQUENTIALSELECTION_H
 #define	SEQUENTIALSELECTION_H
 
-#include <queue>
+#include <vector>
 
 #include "parent_set_selection.h"
+#include "external_layer.h"
 
 namespace parentselection {
 	class SequentialSelection : public ParentSetSelection {
@@ -22,9 +23,25 @@ namespace parentselection {
 		private :
 			void initialize( int variable , FloatMap &pruned , FloatMap &cache ) ;
 			void calculateScores_internal( int variable , FloatMap &pruned , FloatMap &cache ) ;
-
-			std::queue<varset> open ;
-			FloatMap openCache ;
+			void scoreLayerItem( int index , int variable , FloatMap *cache , std::vector<float> *scores ) ;
+			void expand( int variable , varset parents , float bestSubsetScore , bool kept ) ;
+			bool readChunk() ;
+
+			// the BFS layer being scored, all of its parent sets of the same
+			// size, and the next one, filled by expanding the kept sets
+			ExternalLayer layers[ 2 ] ;
+			ExternalLayer *reading ;
+			ExternalLayer *expanding ;
+
+			// the sets of the current layer read so far, with the best score
+			// of any of their subsets and how many of their immediate subsets
+			// were kept
+			std::vector<varset> layer ;
+			std::vector<float> bestSubsetScores ;
+			std::vector<int> keptSubsets ;
+			size_t chunkSize ;
+
+			std::vector<int> options ;
 	} ;
 }
 
@@ -81,49 +81,51 @@ void structureoptimizer::SimulatedAnnealing::initialize(){
 datastructures::BNStructure structureoptimizer::SimulatedAnnealing::search_internal(){
 	boost::timer::auto_cpu_timer cpu( 6 , "CPU time = %w\n" ) ; // TODO: Rethink location of timer
 
+	// Moves are scored from the two positions they change and accepted
+	// in place, the best order is only copied when it improves
 	float cooling_rate = -log( tempMax / tempMin ) ;
-	structureoptimizer::PermutationSet* best = NULL ;
+	std::vector<int> bestOrder ;
+	float bestScore = 0.0 ;
 	int counter = 0 , numIterations = 0 ;
 	for(int i = 0 ; i < maxIterations && counter != unchangedIterations && !outOfTime ; i++,numIterations++){
 		float temperature = tempMax * exp( cooling_rate * i / maxIterations ) ;
 		bool hasChange = false ;
 		for(int j = 0 ; j < numRepeats ; j++){
-			structureoptimizer::PermutationSet* neigh = neighbour( current ) ;
-			float accProb = acceptanceProbability( current , neigh , temperature ) ;
+			int index = neighbour() ;
+			float accProb = acceptanceProbability( current->getScore() , current->evaluateSwap( index ) , temperature ) ;
 			if( compare( accProb , random_generator( gen ) ) >= 0 )
-				current = neigh->clone() ;
-			if( best == NULL || current->isBetter( *best ) ){
-				best = current->clone() ;
+				current->applySwap( index ) ;
+			if( bestOrder.empty() || compare( current->getScore() , bestScore ) < 0 ){
+				bestOrder = current->getPermutation() ;
+				bestScore = current->getScore() ;
 				counter = 0 ;
 				hasChange = true ;
 			}
 		}
 		if( hasChange ){
 			printf(" === Iteration %d ===\n" , i+1 ) ;
-			best->print() ;
+			printf("Score = %.6f\n" , bestScore ) ;
 		}else{
 			counter++ ;
 		}
 	}
 	printf("Iterations = %d\n" , numIterations ) ;
 	t->cancel() ;
-	return *(best->getStructure()) ;
+	if( bestOrder.empty() ) bestOrder = current->getPermutation() ;
+	current->setPermutation( bestOrder ) ;
+	datastructures::BNStructure best = *(current->getStructure()) ;
+	delete current ;
+	return best ;
 }
 
-structureoptimizer::PermutationSet* structureoptimizer::SimulatedAnnealing::neighbour( structureoptimizer::PermutationSet* set ){
-	int index = random_generator( variableCount - 1 , gen ) ;
-	structureoptimizer::PermutationSet* newSet = set->clone() ;
-	newSet->swap( index , index + 1 ) ;
-	return newSet ;
+int structureoptimizer::SimulatedAnnealing::neighbour(){
+	// the move swap( index , index + 1 )
+	return random_generator( variableCount - 1 , gen ) ;
 }
 
-float structureoptimizer::SimulatedAnnealing::acceptanceProbability( structureoptimizer::PermutationSet* oldState ,
-																	structureoptimizer::PermutationSet* newState ,
-																	float temperature ){
-	if( newState->isBetter( *oldState ) ) return 1.0 ;
-	float oldEnergy = oldState->getScore() ;
-	float newEnergy = newState->getScore() ;
+float structureoptimizer::SimulatedAnnealing::acceptanceProbability( float oldEnergy , float newEnergy , float temperature ){
+	if( compare( oldEnergy , newEnergy ) > 0 ) return 1.0 ;
 	float diffE = newEnergy - oldEnergy ;
 	if( !useDiffZero && isZero( diffE ) ) return temperature / tempMax ;
 	return exp( -diffE / temperature ) ;
-}
\ No newline at end of file
+}
@@ -29,10 +29,8 @@ namespace structureoptimizer {
 			void initialize() ;
 			datastructures::BNStructure search_internal() ;
 
-			float acceptanceProbability( PermutationSet* oldState ,
-										PermutationSet* newState ,
-										float temperature ) ;
-			PermutationSet* neighbour( PermutationSet* currentState ) ;
+			float acceptanceProbability( float oldEnergy , float newEnergy , float temperature ) ;
+			int neighbour() ;
 
 			void setDefaultParameters() ;
 			void setFileParameters( std::map<std::string,std::string> params ) ;
@@ -11,14 +11,11 @@ inline bool cmp(const std::pair<varset, float>  &p1, const std::pair<varset, flo
 bestscorecalculators::SparseParentBitwise::SparseParentBitwise(const int variable, const int variableCount) {
 	this->variable = variable;
 	this->variableCount = variableCount;
+	this->noParents = VARSET(0);
 }
 
 bestscorecalculators::SparseParentBitwise::~SparseParentBitwise() {
-//    BITSET_FREE(getScoreScratch_);
-//    
-//    for(bitset u : usedParents_) {
-//        BITSET_FREE(u);
-//    }
+	// Do nothing
 }
 
 void bestscorecalculators::SparseParentBitwise::initialize(const scoring::ScoreCache& scoreCache) {
@@ -44,67 +41,136 @@ void bestscorecalculators::SparseParentBitwise::initialize(const scoring::ScoreC
 	}
 
 
-#ifdef DEBUG
-	printf("Creating used parent bitsets\n");
-#endif
-	for(int i = 0; i < scoreCache.getVariableCount(); i++) {
-		usedParents.push_back(BITSET_NEW(parents.size()));
-	}
-
-	// populate the used parents arrays
-
-#ifdef DEBUG
-	printf("Populating used parents\n");
-#endif
+	// find the variables which appear in some parent set
+	std::vector<bool> used(variableCount, false);
 	for(int i = 0; i < parents.size(); i++) {
 		for(int parent = 0; parent < variableCount; parent++) {
 			if (VARSET_GET(parents[i], parent)) {
-				BITSET_SET(usedParents[parent], i);
+				used[parent] = true;
 			}
 		}
 	}
-
-	// now get the inverse of the possible parents sets
-	// later, we will find the remaining possible parents for
-	// a particular variable, X, after adding this variable, l,
-	// as a leaf by doing :
-	// remainingParentSets(X) & ~possibleParents(X, l)    
-#ifdef DEBUG
-	printf("Flipping used parents\n");
-#endif
-	for (int parent = 0; parent < usedParents.size(); parent++) {
-		BITSET_FLIP_ALL(usedParents[parent]);
+	for(int parent = 0; parent < variableCount; parent++) {
+		if (used[parent]) {
+			usedVariables.push_back(parent);
+		}
 	}
 
+	// populate the blocks; later, we will find the remaining possible parents
+	// for a particular variable, X, after adding this variable, l, as a leaf
+	// by doing:
+	// remainingParentSets(X) & ~possibleParents(X, l)
 #ifdef DEBUG
-	printf("Creating scratch bitset\n");
+	printf("Populating unused parents\n");
 #endif
-	getScoreScratch = BITSET_NEW(parents.size());
-#ifdef DEBUG
-	printf("Setting scratch bitset\n");
-#endif
-	BITSET_SET_ALL(getScoreScratch);
+	int blockSize = BLOCK_WORDS * 64;
+	blockCount = (parents.size() + blockSize - 1) / blockSize;
+	unusedParents.assign((size_t) blockCount * usedVariables.size() * BLOCK_WORDS, ~0ULL);
+	for(int i = 0; i < parents.size(); i++) {
+		int block = i / blockSize;
+		int word = (i % blockSize) / 64;
+		for(int u = 0; u < usedVariables.size(); u++) {
+			if (VARSET_GET(parents[i], usedVariables[u])) {
+				unusedParents[(block * usedVariables.size() + u) * BLOCK_WORDS + word] &= ~(1ULL << (i % 64));
+			}
+		}
+	}
 }
 
-float bestscorecalculators::SparseParentBitwise::getScore(varset &pars) {
-	BITSET_SET_ALL(getScoreScratch);
+/**
+ * The index of the first parent set in [from, to) which is a subset of pars,
+ * or to if there is none.
+ */
+int bestscorecalculators::SparseParentBitwise::findFirstSubset(varset &pars, int from, int to) const {
+	if (from >= to) return to;
+
+	// the variables which are not possible parents; a variable set of up to
+	// 512 variables fits on the stack
+	int local[512];
+	std::vector<int> heap;
+	int *absent = local;
+	if (usedVariables.size() > 512) {
+		heap.resize(usedVariables.size());
+		absent = &heap[0];
+	}
 
-	for(int p = 0; p < variableCount; p++) {
-		// if pars contained p, skip it
-		if(VARSET_GET(pars, p)) continue;
+	int absentCount = 0;
+	for(int u = 0; u < usedVariables.size(); u++) {
+		if (!VARSET_GET(pars, usedVariables[u])) {
+			absent[absentCount++] = u;
+		}
+	}
 
-		// otherwise, remove these parents
-		BITSET_AND(getScoreScratch, usedParents[p]);
+	// stop at the first block which still has a parent set
+	const int usedCount = usedVariables.size();
+	const int blockSize = BLOCK_WORDS * 64;
+	for(int block = from / blockSize; block * blockSize < to; block++) {
+		uint64_t remaining[BLOCK_WORDS];
+		for(int w = 0; w < BLOCK_WORDS; w++) {
+			// only the sets in [from, to)
+			int first = block * blockSize + w * 64;
+			int low = std::max(0, std::min(64, from - first));
+			int high = std::max(0, std::min(64, to - first));
+			uint64_t below = low == 64 ? ~0ULL : (1ULL << low) - 1;
+			uint64_t upTo = high == 64 ? ~0ULL : (1ULL << high) - 1;
+			remaining[w] = upTo & ~below;
+		}
+
+		const uint64_t *blockWords = &unusedParents[(size_t) block * usedCount * BLOCK_WORDS];
+		for(int a = 0; a < absentCount; a++) {
+			const uint64_t *words = blockWords + absent[a] * BLOCK_WORDS;
+			for(int w = 0; w < BLOCK_WORDS; w++) {
+				remaining[w] &= words[w];
+			}
+		}
+
+		for(int w = 0; w < BLOCK_WORDS; w++) {
+			if (remaining[w] != 0) {
+				return block * blockSize + w * 64 + __builtin_ctzll(remaining[w]);
+			}
+		}
 	}
 
-	int fsb = BITSET_FIRST_SET_BIT(getScoreScratch);
-	bestIndex = fsb;
+	return to;
+}
 
-	if (fsb < 0) {
+float bestscorecalculators::SparseParentBitwise::scoreAt(int index) const {
+	if (index == scores.size()) {
 		return std::numeric_limits<float>::max();
 	}
+	return scores[index];
+}
 
-	return scores[fsb];
+float bestscorecalculators::SparseParentBitwise::getScore(varset &pars) {
+	bestIndex = findFirstSubset(pars, 0, scores.size());
+	if (bestIndex == scores.size()) {
+		bestIndex = -1;
+		return std::numeric_limits<float>::max();
+	}
+	return scores[bestIndex];
+}
+
+float bestscorecalculators::SparseParentBitwise::getScore(varset &pars, int &index) {
+	index = findFirstSubset(pars, 0, scores.size());
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentBitwise::getScoreAdding(varset &pars, int added, int &index) {
+	if (index < 0) return getScore(pars, index);
+
+	// only a set with the new variable can come before the previous best
+	index = findFirstSubset(pars, 0, index);
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentBitwise::getScoreRemoving(varset &pars, int removed, int &index) {
+	if (index < 0) return getScore(pars, index);
+
+	// the sets before the previous best were not subsets of the larger set
+	if (index < scores.size() && VARSET_GET(parents[index], removed)) {
+		index = findFirstSubset(pars, index + 1, scores.size());
+	}
+	return scoreAt(index);
 }
 
 float bestscorecalculators::SparseParentBitwise::getScore(int index) {
@@ -114,8 +180,7 @@ float bestscorecalculators::SparseParentBitwise::getScore(int index) {
 
 varset &bestscorecalculators::SparseParentBitwise::getParents(int index) {
 	if (index < 0) {
-		VARSET_NEW(ret, 0);
-		return ret;
+		return noParents;
 	}
 	return parents[index];
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #define	SPARSEPARENTBITWISE_H
 
 #define BOOST_DYNAMIC_BITSET_DONT_USE_FRIENDS
+#include <stdint.h>
 #include <vector>
 #include <boost/dynamic_bitset.hpp>
 
@@ -29,6 +30,9 @@ namespace bestscorecalculators {
 			}
 
 			float getScore(varset &pars);
+			float getScore(varset &pars, int &index);
+			float getScoreAdding(varset &pars, int added, int &index);
+			float getScoreRemoving(varset &pars, int removed, int &index);
 
 			varset &getParents() {
 				return parents[bestIndex];
@@ -40,8 +44,8 @@ namespace bestscorecalculators {
 				return parents.size();
 			}
 
-			bitset &getUsedParents(int parent) {
-				return usedParents[parent];
+			bool isConcurrent() {
+				return true;
 			}
 
 			void print() {
@@ -49,13 +53,29 @@ namespace bestscorecalculators {
 			}
 
 		private:
+			// the parent sets are handled in blocks of BLOCK_WORDS * 64, so the
+			// words of one variable in a block fill a cache line
+			static const int BLOCK_WORDS = 8;
+
+			int findFirstSubset(varset &pars, int from, int to) const;
+			float scoreAt(int index) const;
+
 			int variableCount;
 			int variable;
 			int bestIndex;
+			int blockCount;
 			std::vector<varset> parents;
 			std::vector<float> scores;
-			std::vector<bitset> usedParents;
-			bitset getScoreScratch;
+			varset noParents;
+
+			// the variables which are in at least one parent set; the others
+			// never remove a parent set
+			std::vector<int> usedVariables;
+
+			// bit i of unusedParents[(block * usedVariables.size() + u) * BLOCK_WORDS + w]
+			// is set if parent set (block * BLOCK_WORDS + w) * 64 + i does not
+			// contain variable usedVariables[u]
+			std::vector<uint64_t> unusedParents;
 	};
 }
 
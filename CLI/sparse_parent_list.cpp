@@ -40,15 +40,49 @@ void bestscorecalculators::SparseParentList::initialize(const scoring::ScoreCach
 }
 
 float bestscorecalculators::SparseParentList::getScore(varset &pars) {
-	for (bestIndex = 0; bestIndex < scores.size(); bestIndex++) {
-		if (VARSET_AND(pars, parents[bestIndex]) == parents[bestIndex]) break;
+	bestIndex = findFirstSubset(pars, 0, scores.size());
+	return scoreAt(bestIndex);
+}
+
+/**
+ * The index of the first parent set in [from, to) which is a subset of pars,
+ * or to if there is none.
+ */
+int bestscorecalculators::SparseParentList::findFirstSubset(varset &pars, int from, int to) {
+	for (int i = from; i < to; i++) {
+		if (VARSET_IS_SUBSET_OF(parents[i], pars)) return i;
 	}
+	return to;
+}
 
-	if (bestIndex == scores.size()) {
+float bestscorecalculators::SparseParentList::scoreAt(int index) {
+	if (index == scores.size()) {
 		return std::numeric_limits<float>::max();
 	}
+	return scores[index];
+}
+
+float bestscorecalculators::SparseParentList::getScore(varset &pars, int &index) {
+	index = findFirstSubset(pars, 0, scores.size());
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentList::getScoreAdding(varset &pars, int added, int &index) {
+	if (index < 0) return getScore(pars, index);
+
+	// only a set with the new variable can come before the previous best
+	index = findFirstSubset(pars, 0, index);
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentList::getScoreRemoving(varset &pars, int removed, int &index) {
+	if (index < 0) return getScore(pars, index);
 
-	return scores[bestIndex];
+	// the sets before the previous best were not subsets of the larger set
+	if (index < scores.size() && VARSET_GET(parents[index], removed)) {
+		index = findFirstSubset(pars, index + 1, scores.size());
+	}
+	return scoreAt(index);
 }
 
 float bestscorecalculators::SparseParentList::getScore(int index) {
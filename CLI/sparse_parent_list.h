@@ -29,6 +29,9 @@ namespace bestscorecalculators {
 				return scores[0];
 			}
 			float getScore(varset &pars);
+			float getScore(varset &pars, int &index);
+			float getScoreAdding(varset &pars, int added, int &index);
+			float getScoreRemoving(varset &pars, int removed, int &index);
 
 			varset &getParents() {
 				return parents[bestIndex];
@@ -40,11 +43,18 @@ namespace bestscorecalculators {
 				return parents.size();
 			}
 
+			bool isConcurrent() {
+				return true;
+			}
+
 			void print() {
 				printf("Sparse Parent Bitwise, variable: %d, size: %d\n", variable, size());
 			}
 
 		private:
+			int findFirstSubset(varset &pars, int from, int to);
+			float scoreAt(int index);
+
 			int variableCount;
 			int variable;
 			int bestIndex;
@@ -0,0 +1,173 @@
+/*
+ * File:   sparse_parent_simd.cpp
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#include "sparse_parent_simd.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined __SSE4_1__
+#include <smmintrin.h>
+#endif
+
+inline bool cmp(const std::pair<varset, float> &p1, const std::pair<varset, float> &p2) {
+	return p1.second < p2.second;
+}
+
+bestscorecalculators::SparseParentSimd::SparseParentSimd(const int variable, const int variableCount) {
+	this->variable = variable;
+	this->variableCount = variableCount;
+	this->wordCount = (variableCount + 63) / 64;
+	this->noParents = VARSET(0);
+}
+
+bestscorecalculators::SparseParentSimd::~SparseParentSimd() {
+	// Do nothing
+}
+
+void bestscorecalculators::SparseParentSimd::initialize(const scoring::ScoreCache& scoreCache) {
+	// the same order as SparseParentList, so both find the same index
+	std::vector<std::pair<varset, float> > spg(scoreCache.getCache(variable)->begin(), scoreCache.getCache(variable)->end());
+	std::sort(spg.begin(), spg.end(), cmp);
+
+	for (int i = 0; i < spg.size(); ++i) {
+		parents.push_back(spg[i].first);
+		scores.push_back(spg[i].second);
+	}
+
+	int count = parents.size();
+	masks.resize(wordCount * count);
+	for (int w = 0; w < wordCount; w++) {
+		for (int i = 0; i < count; i++) {
+			masks[w * count + i] = varsetWord(parents[i], w);
+		}
+	}
+}
+
+/**
+ * The index of the first parent set in [from, to) with no variable outside
+ * of the possible parents, given the complement of the possible parents, or
+ * to if there is none.
+ */
+int bestscorecalculators::SparseParentSimd::findFirstSubset(const uint64_t *notPars, int from, int to) const {
+	int count = scores.size();
+	if (from >= to) return to;
+
+	const uint64_t *m = &masks[0];
+	int i = from;
+
+#ifdef __AVX2__
+	const __m256i zero = _mm256_setzero_si256();
+	for (; i + 8 <= to; i += 8) {
+		__m256i low = _mm256_cmpeq_epi64(zero, zero);
+		__m256i high = low;
+		for (int w = 0; w < wordCount; w++) {
+			__m256i np = _mm256_set1_epi64x(notPars[w]);
+			const uint64_t *words = m + w * count + i;
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (words));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (words + 4));
+			low = _mm256_and_si256(low, _mm256_cmpeq_epi64(_mm256_and_si256(a, np), zero));
+			high = _mm256_and_si256(high, _mm256_cmpeq_epi64(_mm256_and_si256(b, np), zero));
+		}
+		int hits = _mm256_movemask_pd(_mm256_castsi256_pd(low)) | (_mm256_movemask_pd(_mm256_castsi256_pd(high)) << 4);
+		if (hits != 0) {
+			return i + __builtin_ctz(hits);
+		}
+	}
+#elif defined __SSE4_1__
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 2 <= to; i += 2) {
+		__m128i hit = _mm_cmpeq_epi64(zero, zero);
+		for (int w = 0; w < wordCount; w++) {
+			__m128i np = _mm_set1_epi64x(notPars[w]);
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*> (m + w * count + i));
+			hit = _mm_and_si128(hit, _mm_cmpeq_epi64(_mm_and_si128(a, np), zero));
+		}
+		int hits = _mm_movemask_pd(_mm_castsi128_pd(hit));
+		if (hits != 0) {
+			return i + __builtin_ctz(hits);
+		}
+	}
+#endif
+
+	for (; i < to; i++) {
+		bool subset = true;
+		for (int w = 0; w < wordCount && subset; w++) {
+			subset = (m[w * count + i] & notPars[w]) == 0;
+		}
+		if (subset) {
+			return i;
+		}
+	}
+	return to;
+}
+
+int bestscorecalculators::SparseParentSimd::findFirstSubset(varset &pars, int from, int to) const {
+	// a variable set of up to 512 variables fits on the stack
+	uint64_t local[8];
+	std::vector<uint64_t> heap;
+	uint64_t *notPars = local;
+	if (wordCount > 8) {
+		heap.resize(wordCount);
+		notPars = &heap[0];
+	}
+
+	for (int w = 0; w < wordCount; w++) {
+		notPars[w] = ~varsetWord(pars, w);
+	}
+
+	return findFirstSubset(notPars, from, to);
+}
+
+float bestscorecalculators::SparseParentSimd::scoreAt(int index) const {
+	if (index == scores.size()) {
+		return std::numeric_limits<float>::max();
+	}
+	return scores[index];
+}
+
+float bestscorecalculators::SparseParentSimd::getScore(varset &pars) {
+	bestIndex = findFirstSubset(pars, 0, scores.size());
+	return scoreAt(bestIndex);
+}
+
+float bestscorecalculators::SparseParentSimd::getScore(varset &pars, int &index) {
+	index = findFirstSubset(pars, 0, scores.size());
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentSimd::getScoreAdding(varset &pars, int added, int &index) {
+	if (index < 0) return getScore(pars, index);
+
+	// only a set with the new variable can come before the previous best
+	index = findFirstSubset(pars, 0, index);
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentSimd::getScoreRemoving(varset &pars, int removed, int &index) {
+	if (index < 0) return getScore(pars, index);
+
+	// the sets before the previous best were not subsets of the larger set
+	if (index < scores.size() && VARSET_GET(parents[index], removed)) {
+		index = findFirstSubset(pars, index + 1, scores.size());
+	}
+	return scoreAt(index);
+}
+
+float bestscorecalculators::SparseParentSimd::getScore(int index) {
+	if (index < 0) return 0;
+	return scores[index];
+}
+
+varset &bestscorecalculators::SparseParentSimd::getParents(int index) {
+	if (index < 0) {
+		return noParents;
+	}
+	return parents[index];
+}
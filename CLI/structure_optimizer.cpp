@@ -15,6 +15,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/thread.hpp>
+#include <boost/random/seed_seq.hpp>
 
 #include "utils.h"
 #include "structure_optimizer.h"
@@ -76,30 +77,20 @@ void structureoptimizer::StructureOptimizer::timeout( const boost::system::error
 	outOfTime = true ;
 }
 
-datastructures::BNStructure structureoptimizer::StructureOptimizer::search( int numSolutions , int timePerSolution ){
+datastructures::BNStructure structureoptimizer::StructureOptimizer::search( int numSolutions , int timePerSolution , int totalTime ){
 	setbuf( stdout , NULL ) ; // In case output to file
 
+	boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds( totalTime ) ;
 	datastructures::BNStructure best ;
 	for(int k = 0 ; k < numSolutions ; k++){
-		// Timer
-		outOfTime = false ;
-		boost::asio::io_service io_t ;
-		t = new boost::asio::deadline_timer( io_t ) ;
-	
-		// Structure learning method
-		datastructures::BNStructure current ;
-		initialize() ;
-		if( timePerSolution > 0 ){
-			t->expires_from_now( boost::posix_time::seconds( timePerSolution ) ) ;
-			t->async_wait( boost::bind( &structureoptimizer::StructureOptimizer::timeout, this, boost::asio::placeholders::error ) ) ;
-			auto thread = boost::async( boost::bind( &structureoptimizer::StructureOptimizer::search_internal , this ) ) ;
-			io_t.run() ;
-			current = thread.get() ;
-			io_t.stop() ;
-		}else{
-			current = search_internal() ;
+		long timeLimit = timePerSolution * 1000L ;
+		if( totalTime > 0 ){
+			long remaining = ( deadline - boost::posix_time::microsec_clock::universal_time() ).total_milliseconds() ;
+			if( remaining <= 0 && k > 0 ) break ;
+			if( timeLimit <= 0 || remaining < timeLimit ) timeLimit = std::max( remaining , 1L ) ;
 		}
-				
+		datastructures::BNStructure current = searchOnce( timeLimit ) ;
+
 		// Update best solution
 		if( best.size() == 0 || current.isBetter( best ) )
 			best = current ;
@@ -107,4 +98,37 @@ datastructures::BNStructure structureoptimizer::StructureOptimizer::search( int
 	printf(" === BEST === \n" ) ;
 	printf( "Score = %.6f\n" , best.getScore() ) ;
 	return best ;
-}
\ No newline at end of file
+}
+
+datastructures::BNStructure structureoptimizer::StructureOptimizer::searchOnce( long timeLimit ){
+	// Timer
+	outOfTime = false ;
+	deadline = boost::posix_time::ptime( boost::posix_time::pos_infin ) ;
+	boost::asio::io_service io_t ;
+	t = new boost::asio::deadline_timer( io_t ) ;
+
+	// Structure learning method
+	datastructures::BNStructure current ;
+	initialize() ;
+	if( timeLimit > 0 ){
+		deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds( timeLimit ) ;
+		t->expires_from_now( boost::posix_time::milliseconds( timeLimit ) ) ;
+		t->async_wait( boost::bind( &structureoptimizer::StructureOptimizer::timeout, this, boost::asio::placeholders::error ) ) ;
+		auto thread = boost::async( boost::bind( &structureoptimizer::StructureOptimizer::search_internal , this ) ) ;
+		io_t.run() ;
+		current = thread.get() ;
+		io_t.stop() ;
+	}else{
+		current = search_internal() ;
+	}
+	delete t ;
+	return current ;
+}
+
+void structureoptimizer::StructureOptimizer::setSeed( unsigned int seed , int restart ){
+	// separate streams for every restart, and for the search and the initializer
+	boost::random::seed_seq searchSeed = { seed , (unsigned int) restart , 0u } ;
+	boost::random::seed_seq initializerSeed = { seed , (unsigned int) restart , 1u } ;
+	gen.seed( searchSeed ) ;
+	initializer->setSeed( initializerSeed ) ;
+}
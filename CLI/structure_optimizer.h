@@ -21,7 +21,16 @@
 namespace structureoptimizer {
 	class StructureOptimizer {
 		public :
-			datastructures::BNStructure search( int numSolutions , int timePerSolution ) ;
+			virtual ~StructureOptimizer(){}
+
+			datastructures::BNStructure search( int numSolutions , int timePerSolution , int totalTime = 0 ) ;
+
+			// One search from a new initial solution, stopped after timeLimit
+			// milliseconds if it is positive
+			datastructures::BNStructure searchOnce( long timeLimit ) ;
+
+			// Restart the random streams of the search and of its initializer
+			void setSeed( unsigned int seed , int restart ) ;
 
 			// Abstract methods
 			virtual void printParameters() = 0 ;
@@ -47,6 +56,7 @@ namespace structureoptimizer {
 			// Timer variables
 			boost::asio::io_service io ;
 			boost::asio::deadline_timer *t ;
+			boost::posix_time::ptime deadline ; // of the current search, pos_infin if none
 			bool outOfTime ;
 	} ;
 }
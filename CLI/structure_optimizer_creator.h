@@ -16,6 +16,7 @@
 #include "tabu_search.h"
 #include "beam_search.h"
 #include "swap_search.h"
+#include "island_search.h"
 
 namespace structureoptimizer {
 	static std::string structureOptimizerString = "The method for structure learning. [\"greedy_search\", \"acyclic_selection\"]";
@@ -36,10 +37,12 @@ namespace structureoptimizer {
 			sto = new BeamSearch( initializer , bestScoreCalculators , structureParameterFile ) ;
 		}else if( type == "swap_search" ){
 			sto = new SwapSearch( initializer , bestScoreCalculators , structureParameterFile ) ;
+		}else if( type == "island_search" ){
+			sto = new IslandSearch( initializer , bestScoreCalculators , structureParameterFile ) ;
 		}else{
 			throw std::runtime_error( "Invalid algorithm selection: '" + type + 
 					"'.  Valid options are 'greedy_search', " +
-					"'acyclic_selection', 'simulated_annealing', 'tabu_search', 'beam_search' and 'swap_search'" ) ;
+					"'acyclic_selection', 'simulated_annealing', 'tabu_search', 'beam_search', 'swap_search' and 'island_search'" ) ;
 		}
 		return sto ;
 	}
@@ -0,0 +1,102 @@
+/*
+ * File:   subset_trie.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SUBSET_TRIE_H
+#define	SUBSET_TRIE_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "typedefs.h"
+
+namespace datastructures {
+	/**
+	 * A set of varsets stored as a trie over their variables in increasing
+	 * order, so asking whether it holds a subset of {@code vs} only follows
+	 * the branches made of variables of {@code vs}.  With at most k parents a
+	 * query visits at most 2^k nodes, and usually far fewer.
+	 */
+	class SubsetTrie {
+		public :
+			SubsetTrie(){
+				clear() ;
+			}
+
+			void clear(){
+				nodes.assign( 1 , Node() ) ;
+			}
+
+			void insert( const varset &vs ){
+				std::vector<int> variables = getVariables( vs ) ;
+				int node = 0 ;
+				for(int i = 0 ; i < variables.size() ; i++){
+					int next = getChild( node , variables[ i ] ) ;
+					if( next < 0 ){
+						next = nodes.size() ;
+						std::vector< std::pair<int,int> > &children = nodes[ node ].children ;
+						children.insert( std::lower_bound( children.begin() , children.end() , std::make_pair( variables[ i ] , -1 ) ) ,
+											std::make_pair( variables[ i ] , next ) ) ;
+						nodes.push_back( Node() ) ; // may move children, so after the insert
+					}
+					node = next ;
+				}
+				nodes[ node ].isEnd = true ;
+			}
+
+			/**
+			 * Whether some varset inserted is a subset of {@code vs},
+			 * including {@code vs} itself.
+			 */
+			bool containsSubsetOf( const varset &vs ) const {
+				std::vector<int> variables = getVariables( vs ) ;
+				return containsSubsetOf( 0 , variables , 0 ) ;
+			}
+
+		private :
+			struct Node {
+				Node() : isEnd( false ) {}
+
+				bool isEnd ;
+				// ( variable , node ) sorted by variable
+				std::vector< std::pair<int,int> > children ;
+			} ;
+
+			bool containsSubsetOf( int node , const std::vector<int> &variables , int first ) const {
+				if( nodes[ node ].isEnd ) return true ;
+				for(int i = first ; i < variables.size() ; i++){
+					int next = getChild( node , variables[ i ] ) ;
+					if( next >= 0 && containsSubsetOf( next , variables , i + 1 ) ) return true ;
+				}
+				return false ;
+			}
+
+			int getChild( int node , int variable ) const {
+				const std::vector< std::pair<int,int> > &children = nodes[ node ].children ;
+				std::vector< std::pair<int,int> >::const_iterator it =
+						std::lower_bound( children.begin() , children.end() , std::make_pair( variable , -1 ) ) ;
+				if( it == children.end() || it->first != variable ) return -1 ;
+				return it->second ;
+			}
+
+			static std::vector<int> getVariables( const varset &vs ){
+				std::vector<int> variables ;
+				for(int word = 0 ; 64 * word < (int) vs.size() ; word++){
+					uint64_t bits = varsetWord( vs , word ) ;
+					while( bits ){
+						variables.push_back( 64 * word + __builtin_ctzll( bits ) ) ;
+						bits &= bits - 1 ;
+					}
+				}
+				return variables ;
+			}
+
+			std::vector<Node> nodes ;
+	} ;
+}
+
+#endif	/* SUBSET_TRIE_H */
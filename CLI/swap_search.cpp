@@ -18,7 +18,7 @@
 #include "permutation_set_creator.h"
 
 structureoptimizer::SwapSearch::SwapSearch(){
-	// Do nothing
+	this->evaluator = NULL ;
 }
 
 structureoptimizer::SwapSearch::SwapSearch( initializers::Initializer* initializer ,
@@ -30,23 +30,29 @@ structureoptimizer::SwapSearch::SwapSearch( initializers::Initializer* initializ
 	this->gen = boost::mt19937( time( NULL ) ) ;
 	
 	setParameters( parametersFile ) ;
+	this->evaluator = new NeighbourhoodEvaluator( this->bestScoreCalculators , threadCount ) ;
 }
 
 structureoptimizer::SwapSearch::~SwapSearch(){
-	// Do nothing
+	delete evaluator ;
 }
 
 void structureoptimizer::SwapSearch::setDefaultParameters(){
 	this->maxIterations = 500 ;
+	this->threadCount = 1 ;
 }
 
 void structureoptimizer::SwapSearch::setFileParameters( std::map<std::string,std::string> params ){
 	if( params.count( "max_iterations" ) )
 		sscanf( params[ "max_iterations" ].c_str() , "%d" , &maxIterations ) ;
+
+	if( params.count( "threads" ) )
+		sscanf( params[ "threads" ].c_str() , "%d" , &threadCount ) ;
 }
 
 void structureoptimizer::SwapSearch::printParameters(){
 	printf( "Max number of iterations: %d\n" , maxIterations ) ;
+	printf( "Threads: %d\n" , evaluator->getThreadCount() ) ;
 }
 
 void structureoptimizer::SwapSearch::initialize(){
@@ -64,12 +70,15 @@ datastructures::BNStructure structureoptimizer::SwapSearch::search_internal(){
 	structureoptimizer::PermutationSet* bestSol = NULL ;
 	for(int i = 0 ; i < maxIterations && !outOfTime ; i++){
 		structureoptimizer::PermutationSet* bestNeighbour = findBestNeighbour( current ) ;
-		if( !bestNeighbour->isBetter( *current ) ){
+		bool improved = bestNeighbour->isBetter( *current ) ;
+		delete current ;
+		if( !improved ){
 			printf("Swap = %s\n" , setType == 0 ? "Greedy -> Acyclic" : "Acyclic -> Greedy" ) ;
 			setType = 1 - setType ;
+			delete bestNeighbour ;
 			current = createSet( setType , variableCount , bestScoreCalculators ) ;
 		}else{
-			current = bestNeighbour->clone() ;
+			current = bestNeighbour ;
 		}
 		printf(" === Iteration %d ===\n" , i+1 ) ;
 		current->print() ;
@@ -83,17 +92,14 @@ datastructures::BNStructure structureoptimizer::SwapSearch::search_internal(){
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::SwapSearch::findBestNeighbour( structureoptimizer::PermutationSet* set ){
-	structureoptimizer::PermutationSet* bestN = set->clone() ;
-	for(int i = 0 ; i < variableCount - 1 ; i++){
-		structureoptimizer::PermutationSet* neighbour = doSwap( set , i ) ;
-		if( !neighbour->isBetter( *bestN ) ) continue ;
-		bestN = neighbour->clone() ;
-	}
-	return bestN ;
+	// Only score the neighbours, the best one is built at the end
+	int bestSwap = evaluator->findBestSwap( set ) ;
+	if( bestSwap < 0 ) return set->clone() ;
+	return doSwap( set , bestSwap ) ;
 }
 
 structureoptimizer::PermutationSet* structureoptimizer::SwapSearch::doSwap( structureoptimizer::PermutationSet* set , int index ){
 	structureoptimizer::PermutationSet* newSet = set->clone();
-	newSet->swap( index , index + 1 ) ;
+	newSet->applySwap( index ) ;
 	return newSet ;
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "structure_optimizer.h"
+#include "neighbourhood_evaluator.h"
 #include "permutation_set.h"
 
 namespace structureoptimizer {
@@ -41,9 +42,11 @@ namespace structureoptimizer {
 			void setFileParameters( std::map<std::string,std::string> params ) ;
 
 			PermutationSet* current ;
+			NeighbourhoodEvaluator* evaluator ;
 
 			// Configurable Parameters
 			int maxIterations ;
+			int threadCount ;
 	} ;
 }
 
@@ -14,9 +14,10 @@
 
 #include "tabu_search.h"
 #include "tabu_list.h"
+#include "utils.h"
 
 structureoptimizer::TabuSearch::TabuSearch(){
-	// Do nothing
+	this->evaluator = NULL ;
 }
 
 structureoptimizer::TabuSearch::TabuSearch( initializers::Initializer* initializer ,
@@ -28,18 +29,20 @@ structureoptimizer::TabuSearch::TabuSearch( initializers::Initializer* initializ
 	this->gen = boost::mt19937( time( NULL ) ) ;
 
 	setParameters( parametersFile ) ;
+	this->evaluator = new NeighbourhoodEvaluator( this->bestScoreCalculators , threadCount ) ;
 	
 	this->tabuList = datastructures::TabuList( lengthTabuList , variableCount ) ;
 }
 
 structureoptimizer::TabuSearch::~TabuSearch(){
-	// Do nothing
+	delete evaluator ;
 }
 
 void structureoptimizer::TabuSearch::setDefaultParameters(){
 	this->lengthTabuList = 0.2 * variableCount ;
 	this->maxIterations = 500 ;
 	this->useAspirationCriterion = false ;
+	this->threadCount = 1 ;
 }
 
 void structureoptimizer::TabuSearch::setFileParameters( std::map<std::string, std::string> params ){
@@ -54,12 +57,16 @@ void structureoptimizer::TabuSearch::setFileParameters( std::map<std::string, st
 		sscanf( params[ "use_aspiration_criterion" ].c_str() , "%d" , &p ) ;
 		useAspirationCriterion = ( p > 0 ) ;
 	}
+
+	if( params.count( "threads" ) )
+		sscanf( params[ "threads" ].c_str() , "%d" , &threadCount ) ;
 }
 
 void structureoptimizer::TabuSearch::printParameters(){
 	printf( "Max number of iterations: %d\n" , maxIterations ) ;
 	printf( "Length of tabu list: %d\n" , lengthTabuList ) ;
 	printf( "Use aspiration criterion: %s\n" , useAspirationCriterion ? "true" : "false" ) ;
+	printf( "Threads: %d\n" , evaluator->getThreadCount() ) ;
 }
 
 void structureoptimizer::TabuSearch::initialize(){
@@ -76,10 +83,14 @@ datastructures::BNStructure structureoptimizer::TabuSearch::search_internal(){
 	int numIterations = 0 ;
 	for(int i = 0 ; i < maxIterations && !outOfTime ; i++,numIterations++){
 		structureoptimizer::PermutationSet* bestNeighbour = findBestNeighbour( current ) ;
-		if( !bestNeighbour->isBetter( *current ) ) break ;
+		if( !bestNeighbour->isBetter( *current ) ){
+			delete bestNeighbour ;
+			break ;
+		}
 		tabuList.add( (*current)[ bestSwap ] , (*current)[ bestSwap + 1 ] ) ;
 		printf(" === Iteration %d ===\n" , i+1 ) ;
-		current = bestNeighbour->clone() ;
+		delete current ;
+		current = bestNeighbour ;
 		current->print() ;
 	}
 	printf("Iterations = %d\n" , numIterations ) ;
@@ -89,20 +100,17 @@ datastructures::BNStructure structureoptimizer::TabuSearch::search_internal(){
 
 structureoptimizer::PermutationSet* structureoptimizer::TabuSearch::findBestNeighbour(
 														structureoptimizer::PermutationSet* currentState ){
+	// Only score the neighbours, the best one is built at the end
+	tabuMoves.assign( variableCount - 1 , false ) ;
+	if( !useAspirationCriterion )
+		for(int i = 0 ; i < variableCount - 1 ; i++)
+			tabuMoves[ i ] = isTabuMove( currentState , i ) ;
+	int bestMove = evaluator->findBestSwap( currentState , tabuMoves ) ;
 	structureoptimizer::PermutationSet* bestN = currentState->clone() ;
-//	int cont = 0 ;
-	for(int i = 0 ; i < variableCount - 1 ; i++){
-		if( !useAspirationCriterion && isTabuMove( currentState , i ) ){
-//			cont++ ;
-			continue ;
-		}
-		structureoptimizer::PermutationSet* neighbour = currentState->clone() ;
-		neighbour->swap( i , i + 1 ) ;
-		if( !neighbour->isBetter( *bestN ) ) continue ;
-		bestN = neighbour->clone() ;
-		bestSwap = i ;
+	if( bestMove >= 0 ){
+		bestN->applySwap( bestMove ) ;
+		bestSwap = bestMove ;
 	}
-//	if( cont > 1 ) printf("Tabu moves: %d\n" , cont ) ; // TODO: Delete this
 	return bestN ;
 }
 
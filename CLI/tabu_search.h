@@ -17,6 +17,7 @@
 #include <boost/random.hpp>
 
 #include "structure_optimizer.h"
+#include "neighbourhood_evaluator.h"
 #include "bn_structure.h"
 #include "permutation_set.h"
 #include "tabu_list.h"
@@ -44,12 +45,15 @@ namespace structureoptimizer {
 
 			datastructures::TabuList tabuList ;
 			int bestSwap ;
+			std::vector<bool> tabuMoves ;
 			PermutationSet* current ;
+			NeighbourhoodEvaluator* evaluator ;
 			
 			// Configurable parameters
 			int maxIterations ;
 			int lengthTabuList ;
 			bool useAspirationCriterion ;
+			int threadCount ;
 	} ;
 }
 
@@ -31,9 +31,19 @@ typedef uint8_t byte;
  *  Please note that the macro VARSET_NEW is quite sensitive.  Caveat emptor.
  *  Similarly, VARSET_COPY is very sensitive.
  */
-#define BOOST_VARSET
+//#define BOOST_VARSET
+#define FIXED_VARSET
 //#define NATIVE_VARSET
 
+/**
+ *  The number of bits in a FIXED_VARSET.  It must be 64, 128, 256 or 512 and
+ *  at least the number of variables; build with -DVARSET_WIDTH=... to change
+ *  it.  Operations only touch the words needed for the network at hand.
+ */
+#ifndef VARSET_WIDTH
+#define VARSET_WIDTH 512
+#endif
+
 /**
  *  Decide how to handle dynamic bitsets (i.e., for sparse parent graphs).
  */
@@ -45,7 +55,8 @@ typedef uint8_t byte;
 /**
  *  Decide how to handle unordered maps (i.e., for duplicate detection).
  */
-#define BOOST_MAP
+#define FLAT_MAP
+//#define BOOST_MAP
 //#define GOOGLE_SPARSE_MAP
 //#define GOOGLE_DENSE_MAP
 //#define STD_MAP
@@ -58,6 +69,12 @@ typedef uint8_t byte;
 #include <boost/dynamic_bitset.hpp>
 #include "dynamic_bitset_hash.h"
 typedef boost::dynamic_bitset<> varset;
+#elif defined FIXED_VARSET
+#include "fixed_varset.h"
+typedef FixedVarset<VARSET_WIDTH> varset;
+#endif
+
+#if defined BOOST_VARSET || defined FIXED_VARSET
 
 #define VARSET(size) varset(size)
 #define VARSET_NEW(varname, size) varset varname(size)
@@ -81,6 +98,21 @@ inline int cardinality(varset &vs) {
 	return vs.count();
 }
 
+/**
+ * The 64 bits of {@code vs} starting at variable 64 * {@code word}.
+ */
+inline uint64_t varsetWord(const varset &vs, int word) {
+#ifdef FIXED_VARSET
+	return word < (int) vs.num_blocks() ? vs.getWords()[word] : 0;
+#else
+	uint64_t result = 0;
+	for (int i = 64 * word; i < (int) vs.size() && i < 64 * (word + 1); i++) {
+		if (vs.test(i)) result |= 1ULL << (i - 64 * word);
+	}
+	return result;
+#endif
+}
+
 inline void printVarset( varset &vs ) ;
 
 inline varset nextPermutation( varset &vs ){ // TODO: Need optmization
@@ -160,6 +192,10 @@ byte inline cardinality(varset v) {
     return layer;
 }
 
+inline uint64_t varsetWord(const varset &vs, int word) {
+    return word == 0 ? vs : 0;
+}
+
 inline varset nextPermutation(varset &vs) {
     varset nextVariables; // next permutation of bits
     varset temp = (vs | (vs - 1)) + 1;
@@ -285,8 +321,14 @@ typedef struct BitSetStruct bitset;
  *  Macros related to unordered maps.
  */
 
-#ifdef BOOST_MAP
 #include <boost/unordered_map.hpp>
+
+#ifdef FLAT_MAP
+#include "varset_map.h"
+typedef VarsetMap<varset,float> FloatMap;
+
+
+#elif defined BOOST_MAP
 //typedef boost::unordered_map<varset, Node*> NodeMap;
 //typedef boost::unordered_map<varset, DFSNode*> DFSNodeMap;
 typedef boost::unordered_map<varset,float> FloatMap;
@@ -322,6 +364,18 @@ inline void init_map(FloatMap &map) {
 #endif
 }
 
+/**
+ * Make room in a map for {@code expectedSize} entries in all, so adding them
+ * does not rehash it.
+ */
+inline void reserve_map(FloatMap &map, size_t expectedSize) {
+#if defined(FLAT_MAP) || defined(BOOST_MAP) || defined(STD_MAP)
+	map.reserve(expectedSize);
+#elif defined(GOOGLE_SPARSE_MAP) || defined(GOOGLE_DENSE_MAP)
+	map.resize(expectedSize);
+#endif
+}
+
 inline void init_map(FloatMap *map) {
 #if defined(GOOGLE_SPARSE_MAP) || defined(GOOGLE_DENSE_MAP)
 	map.set_deleted_key(-2);
@@ -341,6 +395,10 @@ typedef std::pair<float,pii> edge ;
 typedef std::pair<int,pii> hnode ; // ID node, in-degree, product of children's in-degrees
 
 typedef std::pair<float,std::pair<varset,varset> > approxStruct ;
+#ifdef FLAT_MAP
+typedef VarsetMap<varset,approxStruct> ApproxMap ;
+#else
 typedef boost::unordered_map<varset,approxStruct> ApproxMap ;
+#endif
 
 #endif	/* TYPEDEFS_H */
\ No newline at end of file
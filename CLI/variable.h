@@ -56,11 +56,22 @@ namespace datastructures {
 			}
 
 			void addValues(RecordFile &recordFile) {
-				std::vector<Record>::iterator it;
-				for (it = recordFile.getRecords().begin(); it < recordFile.getRecords().end(); it++) {
-					addValue((*it).getRecord()[index]);
+				const std::vector<std::string> &columnValues = recordFile.getColumn(index).getValues();
+				for (auto it = columnValues.begin(); it != columnValues.end(); it++) {
+					addValue(*it);
+				}
+			}
+
+			/**
+			 * Map each code of {@code column} to the index of the same value in
+			 * this variable.
+			 */
+			std::vector<int> getValueIndices(const DataColumn &column) {
+				std::vector<int> indices(column.getCardinality());
+				for (int code = 0; code < column.getCardinality(); code++) {
+					indices[code] = getValueIndex(column.getValue(code));
 				}
-				recordFile.getRecords().begin();
+				return indices;
 			}
 
 			void setName(std::string &name) {
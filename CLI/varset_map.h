@@ -0,0 +1,439 @@
+/*
+ * File:   varset_map.h
+ * Author: nonwhite
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef VARSET_MAP_H
+#define	VARSET_MAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * A hash map from variable sets to values which keeps its entries in one
+ * open-addressed array instead of a node per entry.
+ *
+ * Slots are probed in groups of 16.  Every slot has a control byte holding
+ * 7 bits of its hash (or marking it empty or deleted), so a whole group is
+ * matched against the key with one SSE2 comparison and the keys themselves
+ * are only compared on a control byte match.  The full hash of each entry is
+ * kept next to it, so growing the table never hashes a variable set again.
+ *
+ * The interface is the part of boost::unordered_map that FloatMap and
+ * ApproxMap users rely on.  Erasing leaves iterators to other entries valid;
+ * inserting may invalidate all of them.
+ */
+template <typename K, typename V>
+class VarsetMap {
+	public:
+		typedef K key_type;
+		typedef V mapped_type;
+		typedef std::pair<const K, V> value_type;
+		typedef size_t size_type;
+
+		template <typename M, typename T>
+		class Iterator {
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef T value_type;
+				typedef ptrdiff_t difference_type;
+				typedef T *pointer;
+				typedef T &reference;
+
+				Iterator() : map(NULL), slot(0) {
+				}
+
+				Iterator(M *map, size_type slot) : map(map), slot(slot) {
+					skipFree();
+				}
+
+				// allow iterator -> const_iterator
+				template <typename OM, typename OT>
+				Iterator(const Iterator<OM, OT> &other) : map(other.map), slot(other.slot) {
+				}
+
+				T &operator*() const {
+					return map->slots[slot];
+				}
+
+				T *operator->() const {
+					return &map->slots[slot];
+				}
+
+				Iterator &operator++() {
+					slot++;
+					skipFree();
+					return *this;
+				}
+
+				Iterator operator++(int) {
+					Iterator old(*this);
+					++(*this);
+					return old;
+				}
+
+				template <typename OM, typename OT>
+				bool operator==(const Iterator<OM, OT> &other) const {
+					return slot == other.slot;
+				}
+
+				template <typename OM, typename OT>
+				bool operator!=(const Iterator<OM, OT> &other) const {
+					return slot != other.slot;
+				}
+
+			private:
+				template <typename OM, typename OT> friend class Iterator;
+				friend class VarsetMap;
+
+				void skipFree() {
+					while (slot < map->capacity && map->control[slot] < 0) {
+						slot++;
+					}
+				}
+
+				M *map;
+				size_type slot;
+		} ;
+
+		typedef Iterator<VarsetMap, value_type> iterator;
+		typedef Iterator<const VarsetMap, const value_type> const_iterator;
+
+		VarsetMap() {
+			initEmpty();
+		}
+
+		VarsetMap(const VarsetMap &other) {
+			initEmpty();
+			copyFrom(other);
+		}
+
+		VarsetMap(VarsetMap &&other) {
+			initEmpty();
+			swap(other);
+		}
+
+		~VarsetMap() {
+			destroy();
+		}
+
+		VarsetMap &operator=(const VarsetMap &other) {
+			if (this != &other) {
+				VarsetMap copy(other);
+				swap(copy);
+			}
+			return *this;
+		}
+
+		VarsetMap &operator=(VarsetMap &&other) {
+			swap(other);
+			return *this;
+		}
+
+		void swap(VarsetMap &other) {
+			std::swap(control, other.control);
+			std::swap(hashes, other.hashes);
+			std::swap(slots, other.slots);
+			std::swap(capacity, other.capacity);
+			std::swap(entryCount, other.entryCount);
+			std::swap(deleted, other.deleted);
+		}
+
+		iterator begin() {
+			return iterator(this, 0);
+		}
+
+		iterator end() {
+			return iterator(this, capacity);
+		}
+
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, capacity);
+		}
+
+		size_type size() const {
+			return entryCount;
+		}
+
+		bool empty() const {
+			return entryCount == 0;
+		}
+
+		/**
+		 * Make room for {@code entries} entries, so that inserting them does
+		 * not grow the table again.
+		 */
+		void reserve(size_type entries) {
+			size_type needed = GROUP_SIZE;
+			while (needed * MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR < entries) {
+				needed *= 2;
+			}
+			if (needed > capacity) {
+				rehash(needed);
+			}
+		}
+
+		iterator find(const K &key) {
+			return iterator(this, findSlot(key, hashOf(key)));
+		}
+
+		const_iterator find(const K &key) const {
+			return const_iterator(this, findSlot(key, hashOf(key)));
+		}
+
+		size_type count(const K &key) const {
+			return findSlot(key, hashOf(key)) == capacity ? 0 : 1;
+		}
+
+		V &at(const K &key) {
+			size_type slot = findSlot(key, hashOf(key));
+			if (slot == capacity) {
+				throw std::out_of_range("VarsetMap::at");
+			}
+			return slots[slot].second;
+		}
+
+		const V &at(const K &key) const {
+			size_type slot = findSlot(key, hashOf(key));
+			if (slot == capacity) {
+				throw std::out_of_range("VarsetMap::at");
+			}
+			return slots[slot].second;
+		}
+
+		V &operator[](const K &key) {
+			// findOrInsert may move the slots, so call it first
+			size_type slot = findOrInsert(key, V());
+			return slots[slot].second;
+		}
+
+		std::pair<iterator, bool> insert(const value_type &value) {
+			size_type before = entryCount;
+			size_type slot = findOrInsert(value.first, value.second);
+			return std::make_pair(iterator(this, slot), entryCount != before);
+		}
+
+		size_type erase(const K &key) {
+			size_type slot = findSlot(key, hashOf(key));
+			if (slot == capacity) {
+				return 0;
+			}
+			eraseSlot(slot);
+			return 1;
+		}
+
+		void erase(iterator position) {
+			eraseSlot(position.slot);
+		}
+
+		/**
+		 * Remove every entry but keep the memory, as the maps are usually
+		 * filled again to a similar size.
+		 */
+		void clear() {
+			for (size_type slot = 0; slot < capacity; slot++) {
+				if (control[slot] >= 0) {
+					slots[slot].~value_type();
+				}
+			}
+			if (capacity > 0) {
+				memset(control, EMPTY, capacity);
+			}
+			entryCount = 0;
+			deleted = 0;
+		}
+
+	private:
+		static const int8_t EMPTY = -128;
+		static const int8_t DELETED = -2;
+		static const size_type GROUP_SIZE = 16;
+		static const size_type MAX_LOAD_NUMERATOR = 7;
+		static const size_type MAX_LOAD_DENOMINATOR = 8;
+
+		void initEmpty() {
+			control = NULL;
+			hashes = NULL;
+			slots = NULL;
+			capacity = 0;
+			entryCount = 0;
+			deleted = 0;
+		}
+
+		void destroy() {
+			clear();
+			delete[] control;
+			delete[] hashes;
+			::operator delete(slots);
+			initEmpty();
+		}
+
+		void copyFrom(const VarsetMap &other) {
+			if (other.entryCount == 0) return;
+
+			allocate(other.capacity);
+			for (size_type slot = 0; slot < other.capacity; slot++) {
+				if (other.control[slot] >= 0) {
+					place(other.hashes[slot], other.slots[slot].first, other.slots[slot].second);
+				}
+			}
+		}
+
+		void allocate(size_type newCapacity) {
+			capacity = newCapacity;
+			control = new int8_t[capacity];
+			memset(control, EMPTY, capacity);
+			hashes = new size_t[capacity];
+			slots = static_cast<value_type*> (::operator new(capacity * sizeof (value_type)));
+		}
+
+		static size_t hashOf(const K &key) {
+			// spread the bits, the 7 low ones are kept in the control byte
+			uint64_t h = boost::hash<K>()(key);
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 33;
+			return h;
+		}
+
+		static int8_t controlOf(size_t hash) {
+			return hash & 0x7F;
+		}
+
+		/**
+		 * Bit i of the result is set if control byte i of the group at
+		 * {@code group} equals {@code value}.
+		 */
+		static uint32_t match(const int8_t *group, int8_t value) {
+#ifdef __SSE2__
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*> (group));
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)));
+#else
+			uint32_t result = 0;
+			for (size_type i = 0; i < GROUP_SIZE; i++) {
+				if (group[i] == value) result |= 1 << i;
+			}
+			return result;
+#endif
+		}
+
+		size_type findSlot(const K &key, size_t hash) const {
+			if (entryCount == 0) {
+				return capacity;
+			}
+
+			int8_t tag = controlOf(hash);
+			size_type mask = capacity / GROUP_SIZE - 1;
+			size_type group = (hash >> 7) & mask;
+			for (size_type step = 1; ; step++) {
+				const int8_t *groupControl = control + group * GROUP_SIZE;
+				for (uint32_t hits = match(groupControl, tag); hits != 0; hits &= hits - 1) {
+					size_type slot = group * GROUP_SIZE + __builtin_ctz(hits);
+					if (hashes[slot] == hash && slots[slot].first == key) {
+						return slot;
+					}
+				}
+				if (match(groupControl, EMPTY) != 0) {
+					return capacity;
+				}
+				group = (group + step) & mask;
+			}
+		}
+
+		/**
+		 * The first free slot on the probe sequence of {@code hash}.  The table
+		 * must not be full.
+		 */
+		size_type freeSlot(size_t hash) const {
+			size_type mask = capacity / GROUP_SIZE - 1;
+			size_type group = (hash >> 7) & mask;
+			for (size_type step = 1; ; step++) {
+				const int8_t *groupControl = control + group * GROUP_SIZE;
+				uint32_t free = match(groupControl, EMPTY) | match(groupControl, DELETED);
+				if (free != 0) {
+					return group * GROUP_SIZE + __builtin_ctz(free);
+				}
+				group = (group + step) & mask;
+			}
+		}
+
+		size_type place(size_t hash, const K &key, const V &value) {
+			size_type slot = freeSlot(hash);
+			if (control[slot] == DELETED) {
+				deleted--;
+			}
+			control[slot] = controlOf(hash);
+			hashes[slot] = hash;
+			new (&slots[slot]) value_type(key, value);
+			entryCount++;
+			return slot;
+		}
+
+		size_type findOrInsert(const K &key, const V &value) {
+			size_t hash = hashOf(key);
+			size_type slot = findSlot(key, hash);
+			if (slot != capacity) {
+				return slot;
+			}
+
+			if ((entryCount + deleted + 1) * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR) {
+				// only grow if the entries need it, otherwise just drop the tombstones
+				rehash((entryCount + 1) * 2 * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR ? (capacity > 0 ? capacity * 2 : GROUP_SIZE) : capacity);
+			}
+			return place(hash, key, value);
+		}
+
+		void eraseSlot(size_type slot) {
+			slots[slot].~value_type();
+			control[slot] = DELETED;
+			entryCount--;
+			deleted++;
+		}
+
+		void rehash(size_type newCapacity) {
+			int8_t *oldControl = control;
+			size_t *oldHashes = hashes;
+			value_type *oldSlots = slots;
+			size_type oldCapacity = capacity;
+
+			allocate(newCapacity);
+			entryCount = 0;
+			deleted = 0;
+			for (size_type slot = 0; slot < oldCapacity; slot++) {
+				if (oldControl[slot] >= 0) {
+					place(oldHashes[slot], oldSlots[slot].first, oldSlots[slot].second);
+					oldSlots[slot].~value_type();
+				}
+			}
+
+			delete[] oldControl;
+			delete[] oldHashes;
+			::operator delete(oldSlots);
+		}
+
+		int8_t *control;
+		size_t *hashes;
+		value_type *slots;
+		size_type capacity;
+		size_type entryCount;
+		size_type deleted;
+} ;
+
+#endif	/* VARSET_MAP_H */